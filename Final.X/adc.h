@@ -8,9 +8,36 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include "clock.h"
+
+#define ADC_AVG 16  //Conversions averaged by adcAvg0()
+#define ADC_AVG_SHIFT 4 //log2 of ADC_AVG
+#define ADC_ACQ 20  //Acquisition time in ADCRC clocks, ~40us
+#define ADC_PR 77   //Timer4 period, 1MHz/64/78 = 200Hz
+#define ADC_TRIGGER 0x06    //ADACT Timer4 postscaled
+
+//How adcRead0() gets a value, the one shot modes leave the scan stopped
+#define ADC_READ_BACKGROUND 0   //Newest background scan result
+#define ADC_READ_BUSY 1     //adcAvg0(), CPU waits on the burst
+#define ADC_READ_SLEEP 2    //adcSleep0(), CPU sleeps during the burst
+#define ADC_READ ADC_READ_BACKGROUND
+
+//Background scan, ADPCH of each input and its filter shift (0 = no filter)
+#define ADC_CHANNELS 1
+#define ADC_SCAN {0}    //RA0 potentiometer
+#define ADC_SMOOTH {2}
+#define ADC_RA0 0   //Scan index of RA0
 
 void adc_init();
 unsigned long adcNum0();    //Get ADC value
+unsigned long adcAvg0();    //Get averaged ADC value
+unsigned long adcSleep0();  //Get averaged ADC value in Sleep
+unsigned long adcRead0();   //Get ADC value, ADC_READ mode
+void adc_start();   //Start background conversions
+void adc_clock();   //Timer4 dividers for the active clock
+void adc_isr();     //Background conversion interrupt
+unsigned long adcResult(unsigned char i);   //Get newest result of scan input i
+unsigned long adcLatest0(); //Get newest background ADC value
 
 #endif	/* ADC_H */
 
@@ -0,0 +1,137 @@
+/*
+ * Button and switch functions.
+ * Timer2 samples every input at 100Hz. A new level has to be seen for
+ * BTN_DEBOUNCE samples in a row before it is taken, then a press or release
+ * event is queued, and a long press once it has been held for BTN_HOLD.
+ */
+#include "btn.h"
+
+//Pin mask and pressed level of every input
+const unsigned char btn_mask[BTN_COUNT] = {0x04, 0x08, 0x10};
+const unsigned char btn_active[BTN_COUNT] = {0x04, 0x00, 0x00};
+
+//Global Variables
+volatile unsigned char btn_state = 0;   //Debounced, bit set while pressed
+unsigned char btn_count[BTN_COUNT];     //Samples the new level has held
+unsigned char btn_held[BTN_COUNT];      //Ticks pressed, stops at BTN_HOLD
+
+//Event queue, written from the ISR and read from the main loop
+unsigned char btn_qtype[BTN_QUEUE];
+unsigned char btn_qbtn[BTN_QUEUE];
+volatile unsigned char btn_head = 0;
+volatile unsigned char btn_tail = 0;
+
+/*
+ * Add an event to the queue, dropped if the queue is full.
+ */
+void btn_push(unsigned char type, unsigned char btn){
+    unsigned char next = (btn_head+1) & (BTN_QUEUE-1);
+
+    if(next != btn_tail){
+        btn_qtype[btn_head] = type;
+        btn_qbtn[btn_head] = btn;
+        btn_head = next;
+    }
+}
+
+/*
+ * Timer2 dividers for 1:64 at the slow clock, the period stays BTN_PR.
+ */
+void btn_clock(){
+    T2CON = (T2CON & 0x80) | clock_t2con(0b110);
+}
+
+/*
+ * Configures Timer2 as the 100Hz sample tick on the low priority interrupt.
+ * The current levels are taken as the starting state without events.
+ */
+void btn_init(){
+    //Start from the pins as they are
+    unsigned char port = PORTA;
+    for(unsigned char i=0; i<BTN_COUNT; i++){
+        if((port & btn_mask[i]) == btn_active[i]){
+            btn_state |= (1 << i);
+        }
+        btn_count[i] = 0;
+        btn_held[i] = BTN_HOLD;     //No long press for a held start
+    }
+    btn_head = 0;
+    btn_tail = 0;
+    
+    //Timer2 setup
+    T2CLKCONbits.CS = 1;    //FOSC/4
+    T2HLT = 0x00;   //Free running
+    btn_clock();    //1:64, 1:1 at 4MHz
+    T2PR = BTN_PR;
+    T2CONbits.ON = 1;
+    clock_add(btn_clock);
+    
+    //Interrupt enable
+    INTCONbits.IPEN = 1;
+    IPR4bits.TMR2IP = 0;
+    PIR4bits.TMR2IF = 0;
+    PIE4bits.TMR2IE = 1;
+    GIEL = 1;
+    GIEH = 1;
+}
+
+/*
+ * Called from the low priority interrupt.
+ */
+void btn_isr(){
+    if(PIR4bits.TMR2IF){
+        PIR4bits.TMR2IF = 0;
+        btn_tick();
+    }
+}
+
+/*
+ * Sample every input once.
+ */
+void btn_tick(){
+    unsigned char port = PORTA;
+    
+    for(unsigned char i=0; i<BTN_COUNT; i++){
+        unsigned char bit = 1 << i;
+        unsigned char down = ((port & btn_mask[i]) == btn_active[i]);
+        
+        if(down != ((btn_state & bit) != 0)){     //Level differs
+            if(++btn_count[i] >= BTN_DEBOUNCE){
+                btn_count[i] = 0;
+                btn_held[i] = 0;
+                btn_state ^= bit;
+                btn_push(down ? BTN_PRESS : BTN_RELEASE, i);
+            }
+        }
+        else{
+            btn_count[i] = 0;
+            if(down && (btn_held[i] < BTN_HOLD)){
+                if(++btn_held[i] == BTN_HOLD){
+                    btn_push(BTN_LONG, i);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Debounced level of an input, 1 while pressed.
+ */
+unsigned char btn_down(unsigned char btn){
+    return (btn_state >> btn) & 0x01;
+}
+
+/*
+ * Get the next event, BTN_NONE if there is none. The input is written to btn.
+ */
+unsigned char btn_get_event(unsigned char *btn){
+    unsigned char type;
+
+    if(btn_head == btn_tail){
+        return BTN_NONE;
+    }
+    type = btn_qtype[btn_tail];
+    *btn = btn_qbtn[btn_tail];
+    btn_tail = (btn_tail+1) & (BTN_QUEUE-1);
+    return type;
+}
@@ -0,0 +1,37 @@
+/*
+ * Header for button and switch functions.
+ */
+#ifndef BTN_H
+#define	BTN_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+#include "clock.h"
+
+//Inputs on PORTA
+#define BTN_COUNT 3
+#define BTN_MODE 0      //RA2 switch, high is set mode
+#define BTN_NEXT 1      //RA3 button, low when pressed
+#define BTN_ALARM 2     //RA4 button, low when pressed
+
+//Timing in ticks of 10ms
+#define BTN_PR 155      //Timer2 period, 1MHz/64/156 = 100Hz
+#define BTN_DEBOUNCE 3  //Samples a new level has to hold
+#define BTN_HOLD 100    //Held this long is a long press
+
+//Events
+#define BTN_NONE 0
+#define BTN_PRESS 1
+#define BTN_RELEASE 2
+#define BTN_LONG 3
+
+#define BTN_QUEUE 8     //Event queue size, power of 2
+
+void btn_init();
+void btn_clock();
+void btn_isr();
+void btn_tick();
+unsigned char btn_down(unsigned char btn);
+unsigned char btn_get_event(unsigned char *btn);
+
+#endif	/* BTN_H */
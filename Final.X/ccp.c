@@ -3,12 +3,43 @@
  */
 #include "ccp.h"
 #include "lcd.h"
+#include "ir.h"
+#include "clock.h"
 
 //Global Variables
 unsigned long f=0;
 unsigned long f2=0;
 unsigned long f3=0;
-int r=0;
+unsigned char gap=1;    //Timer1 overflowed since the last edge
+unsigned char ccp_shift=0;  //Clock shift Timer1 counts at
+unsigned char ccp_over=0;   //Overflows since the last edge
+
+/*
+ * Count at the Timer1 rate of the last switch to the rate of the active clock.
+ */
+uint16_t ccp_scale(uint16_t t){
+    if(clock_shift() > ccp_shift){
+        return (t < (0xFFFF >> CLOCK_FAST_SHIFT)) ? 
+                (t << CLOCK_FAST_SHIFT) : 0xFFFF;
+    }
+    if(clock_shift() < ccp_shift){
+        return t >> CLOCK_FAST_SHIFT;
+    }
+    return t;
+}
+
+/*
+ * Timer1 counts 8us at the slow clock and 0.5us at the fast, 1:8 is its
+ * largest prescaler. The count since the last edge is rescaled so the period
+ * across a switch stays right, the decoder gets it back in 8us ticks.
+ */
+void ccp_clock(){
+    TMR1 = ccp_scale(TMR1);
+    if(PIR6bits.CCP1IF){    //Edge captured at the old rate
+        CCPR1 = ccp_scale(CCPR1);
+    }
+    ccp_shift = clock_shift();
+}
 
 /*
  *  Initialize ccp and timer1
@@ -23,46 +54,46 @@ void ccp_init(){
     TMR1CLKbits.CS=1;
     TMR1IF=0;
     TMR1ON = 1;
+    ccp_shift = clock_shift();
+    clock_add(ccp_clock);
     
     //CCP setup
     CCP1PPS=0x12;   //Setup input PPS
     CCPR1=0x00;     //Clear
-    CCP1CONbits.MODE=0x05;  //Every edge
+    CCP1CONbits.MODE=0x05;  //Every rising edge
     CCP1CONbits.EN = 1;  //Enable ccp
     CCP1IF=0;
     
+    ir_init();  //Reset decoder
     
     //Interrupt enable
+    TMR1IE = 1; //Overflow marks the line idle
     CCP1IE = 1;
     PEIE = 1;
     GIE = 1;
 }
 
 void __interrupt() ISR(){
-  if (CCP1IF){  //If Capture Event Occurs, load f
+  if (TMR1IF){  //No edge for 524ms, key released
+        TMR1IF = 0;
+        gap = 1;
+        if(++ccp_over >= (1 << ccp_shift)){    //32ms per overflow when fast
+            ccp_over = 0;
+            ir_timeout();
+        }
+  }
+  if (CCP1IF){  //If Capture Event Occurs, pass the period to the decoder
         TMR1 = 0; //Reset
         PIR6bits.CCP1IF = 0;
-      
-        while(!PIR6bits.CCP1IF);    //Wait till the pulse is done
-        PIR6bits.CCP1IF = 0;
-        f = CCPR1;  //First edge 
+        ccp_over = 0;
         
-        if(f>=1680){
-            r=0;
-            __delay_ms(20);
+        if(gap){    //First edge after the line was idle
+            gap = 0;
+            ir_edge(IR_GAP);
         }
-        else if (f>=1410){
-            r=1;
-            __delay_ms(20);
+        else{
+            ir_edge(CCPR1 >> ccp_shift);
         }
-        else if (f>=890){
-            r=2;
-            __delay_ms(20);
-        }
-        
-    
-    //Reset
-    TMR1 = 0;
   }
 }
 
@@ -93,8 +124,3 @@ void __interrupt() ISR(){
     }
     return f3;
 }*/
-
-//Getter of number of hits
-int getr(){
-    return r;
-}
\ No newline at end of file
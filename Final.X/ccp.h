@@ -6,8 +6,8 @@
 #define	CCP_H
 
 void ccp_init();
+void ccp_clock();
 float ccpNum0();
-int getr();
 
 #endif	/* CCP_H */
 
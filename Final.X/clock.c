@@ -0,0 +1,101 @@
+/*
+ * Clock functions.
+ * Switches HFINTOSC between the 4MHz idle clock and 64MHz bursts. Every driver
+ * with FOSC based timing registers a callback that sets its dividers again
+ * from clock_hz() or clock_shift() after each switch. Drivers that never see
+ * a switch run at the slow clock without clock_init().
+ */
+#include "clock.h"
+
+//Global Variables
+void (*clock_fn[CLOCK_USERS])(void);    //Called after every switch
+unsigned char clock_count = 0;  //Callbacks added
+unsigned char clock_speed = CLOCK_SLOW;     //Active speed
+unsigned char clock_sh = 0;     //log2 of FOSC/CLOCK_SLOW_HZ
+
+/*
+ * Start from the slow clock.
+ */
+void clock_init(){
+    OSCFRQ = CLOCK_SLOW_FRQ;
+    while(!OSCSTATbits.HFOR);   //Wait till HFINTOSC is stable
+    clock_speed = CLOCK_SLOW;
+    clock_sh = 0;
+}
+
+/*
+ * Add a callback to run after every switch. Returns its slot, or CLOCK_USERS
+ * if the table is full.
+ */
+unsigned char clock_add(void (*fn)(void)){
+    if(clock_count >= CLOCK_USERS){
+        return CLOCK_USERS;
+    }
+    clock_fn[clock_count] = fn;
+    return clock_count++;
+}
+
+/*
+ * Switch to speed and let every driver set its dividers again. Interrupts are
+ * held off so no ISR sees a timer with the old dividers at the new clock.
+ */
+void clock_set(unsigned char speed){
+    if(speed == clock_speed){
+        return;
+    }
+    
+    unsigned char gie = INTCONbits.GIE;
+    GIE = 0;
+    if(speed == CLOCK_FAST){
+        OSCFRQ = CLOCK_FAST_FRQ;
+        clock_sh = CLOCK_FAST_SHIFT;
+    }
+    else{
+        OSCFRQ = CLOCK_SLOW_FRQ;
+        clock_sh = 0;
+    }
+    clock_speed = speed;
+    while(!OSCSTATbits.HFOR);   //Wait till HFINTOSC is stable
+    
+    for(unsigned char i=0; i<clock_count; i++){
+        clock_fn[i]();
+    }
+    GIE = gie;
+}
+
+/*
+ * Active FOSC in Hz.
+ */
+uint32_t clock_hz(){
+    return CLOCK_SLOW_HZ << clock_sh;
+}
+
+/*
+ * log2 of FOSC over the slow clock, for dividers that are powers of 2.
+ */
+unsigned char clock_shift(){
+    return clock_sh;
+}
+
+/*
+ * FOSC over the slow clock.
+ */
+unsigned char clock_mult(){
+    return 1 << clock_sh;
+}
+
+/*
+ * CKPS and OUTPS bits of a Timer2 style TxCON for a 2^ckps prescaler at the
+ * slow clock. The extra ratio goes on the prescaler up to 1:128 and the rest
+ * on the postscaler, so TxPR stays the same at either clock.
+ */
+unsigned char clock_t2con(unsigned char ckps){
+    unsigned char post = 0;     //Postscaler as a power of 2
+    
+    ckps += clock_sh;
+    if(ckps > 7){
+        post = ckps-7;
+        ckps = 7;
+    }
+    return (ckps << 4) | ((1 << post)-1);
+}
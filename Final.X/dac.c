@@ -4,6 +4,51 @@
 #include "dac.h"
 #include "lcd.h"
 
+//Sine Wave
+const unsigned char sin[DAC_SAMPLES] = {
+    0x80,0x8f,0x9f,0xae,0xbd,0xca,0xd7,0xe2,0xeb,0xf3,
+    0xf9,0xfd,0xff,0xff,0xfd,0xf9,0xf3,0xeb,0xe2,0xd7,
+    0xca,0xbd,0xae,0x9f,0x8f,0x80,0x70,0x60,0x51,0x42,
+    0x35,0x28,0x1d,0x14,0xc,0x6,0x2,0x0,0x0,0x2,
+    0x6,0xc,0x14,0x1d,0x28,0x35,0x42,0x51,0x60,0x70
+};
+//Triangle Wave
+const unsigned char triangle[DAC_SAMPLES] = {
+    0xa,0x14,0x1f,0x29,0x33,0x3d,0x47,0x52,0x5c,0x66,
+    0x70,0x7a,0x85,0x8f,0x99,0xa3,0xad,0xb8,0xc2,0xcc,
+    0xd6,0xe0,0xeb,0xf5,0xff,0xf5,0xeb,0xe0,0xd6,0xcc,
+    0xc2,0xb8,0xad,0xa3,0x99,0x8f,0x85,0x7a,0x70,0x66,
+    0x5c,0x52,0x47,0x3d,0x33,0x29,0x1f,0x14,0xa,0x0
+};
+//Sawtooth Wave
+const unsigned char sawtooth[DAC_SAMPLES] = {
+    0x5,0xa,0xf,0x14,0x1a,0x1f,0x24,0x29,0x2e,0x33,
+    0x38,0x3d,0x42,0x47,0x4d,0x52,0x57,0x5c,0x61,0x66,
+    0x6b,0x70,0x75,0x7a,0x80,0x85,0x8a,0x8f,0x94,0x99,
+    0x9e,0xa3,0xa8,0xad,0xb3,0xb8,0xbd,0xc2,0xc7,0xcc,
+    0xd1,0xd6,0xdb,0xe0,0xe6,0xeb,0xf0,0xf5,0xfa,0xff
+};
+
+//Global Variables
+const unsigned char *dac_table = sin;   //Wave of the channel
+unsigned char dac_index = 0;    //Next sample
+
+/*
+ * SPI2 clock of DAC_SPI_HZ at the active FOSC, FOSC/4 at the slow clock and
+ * the baud rate divider above it.
+ */
+void spi_clock(){
+    SSP2CON1bits.SSPEN = 0;
+    if(clock_hz()/4 <= DAC_SPI_HZ){
+        SSP2CON1bits.SSPM = 0;  //FOSC/4
+    }
+    else{
+        SSP2ADD = (clock_hz()/(4*DAC_SPI_HZ))-1;
+        SSP2CON1bits.SSPM = 0b1010;     //FOSC/(4*(SSP2ADD+1))
+    }
+    SSP2CON1bits.SSPEN = 1;
+}
+
 /*
  * Configures SPI1, uses PortC for the DAC LTC1661.
  * The output rate specified by the frequency.
@@ -13,10 +58,9 @@ void spi_init(){
     SSP2STATbits.SMP = 1;
     //Transmit
     SSP2STATbits.CKE = 1;
-    //Enables the needed pins (master,slave,data,enable)
-    SSP2CON1bits.SSPEN = 1;
-    //Clk =FOSC/64
-    SSP2CON1bits.SSPM = 2;
+    //Clk =1MHz, a sample is sent from the tick ISR so keep it short
+    spi_clock();
+    clock_add(spi_clock);
 
     TRISBbits.TRISB0 = 0;   //Select
     TRISBbits.TRISB3 = 0;   //CLK
@@ -50,4 +94,33 @@ void spi_write(unsigned char data){
     while(!SSP2STATbits.BF);    //Wait till it finish writing from buffer
     
     LATBbits.LATB0 = 1;     //Disable output
-}
\ No newline at end of file
+}
+
+/*
+ * Select the wave of a channel, the tick ISR plays it.
+ */
+void dac_wave(unsigned char channel){
+    GIEL = 0;   //Pointer is more than a byte
+    switch(channel){
+        case 1:
+            dac_table = triangle;
+            break;
+        case 2:
+            dac_table = sawtooth;
+            break;
+        default:
+            dac_table = sin;
+            break;
+    }
+    GIEL = 1;
+}
+
+/*
+ * Called from the 1ms tick, send the next sample of the wave.
+ */
+void dac_tick(){
+    spi_write(dac_table[dac_index]);
+    if(++dac_index >= DAC_SAMPLES){
+        dac_index = 0;
+    }
+}
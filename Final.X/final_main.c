@@ -21,37 +21,395 @@
 
 //Includes files
 #include "adc.h"
+#include "btn.h"
 #include "lcd.h"
 #include "i2c.h"
 #include "timer.h"
 #include "dac.h"
+#include "tone.h"
 #include "ccp.h"
+#include "ir.h"
+#include "sched.h"
+#include "clock.h"
 
 //Configuration
 #pragma config WDTE = OFF   //Disable watch dog timer
 #pragma config LVP = ON      //Enable low voltage programming mode
 
+#define CHANNELS 3  //Number of DAC tones
+
+//Task periods in 1ms ticks
+#define INPUT_MS 10     //Buttons and remote, 100Hz
+#define DISPLAY_MS 500  //LCD and setting the time, 2Hz
+#define RTC_MS 1000     //Alarm check, 1Hz
+
 //Global Variable
 unsigned long value0 = 0;   //Where to store the ADC result
+int setNum=0;   //Switch case selection
+int AsetNum=0;   //Alarm switch case selection
+int alarm = 0;  //alarm flag
+int check = 0;  //Check flag
+int alarmON = 0;    //Speaker alarm on 
+int channel=0;  //Channel number
+unsigned char ringing = 0;  //Alarm tone playing
+unsigned char rtc_task = 0;     //Scheduler slot of task_rtc
+
+/*
+ * Apply the pending remote events to the channel. Held channel up/down only
+ * arrive at the auto-repeat rate, so the channel changes once per step.
+ */
+int remote_channel(int channel){
+    unsigned char key;  //Key of the event
+    unsigned char event;    //Press, repeat or release
+
+    while((event = ir_get_event(&key)) != IR_NONE){
+        if(event == IR_RELEASE){
+            continue;
+        }
+        switch(key){
+            case IR_KEY_CH_UP:
+                channel = (channel+1)%CHANNELS;
+                break;
+            case IR_KEY_CH_DOWN:
+                channel = (channel+CHANNELS-1)%CHANNELS;
+                break;
+            case IR_KEY_0:
+                channel = 0;
+                break;
+            case IR_KEY_1:
+                channel = 1;
+                break;
+            case IR_KEY_2:
+                channel = 2;
+                break;
+            default:
+                break;
+        }
+    }
+    return channel;
+}
+
+/*
+ * Input task. Buttons and remote events, never waits.
+ */
+void task_input(){
+    //Button events
+    unsigned char btn;  //Input of the event
+    unsigned char event;    //Press, release or long press
+    while((event = btn_get_event(&btn)) != BTN_NONE){
+        if((btn == BTN_NEXT) && (event == BTN_PRESS)){  //Next selection
+            if(btn_down(BTN_MODE)){
+                setNum = (setNum+1)%4;
+                LATCbits.LATC0 = 1;
+            }
+            else{
+                AsetNum = (AsetNum+1)%4;
+                LATCbits.LATC1 = 1;
+            }
+        }
+        else if((btn == BTN_NEXT) && (event == BTN_LONG)){  //Stop setting
+            setNum = 0;
+            AsetNum = 0;
+        }
+        else if((btn == BTN_NEXT) && (event == BTN_RELEASE)){
+            LATCbits.LATC0 = 0;     //Whichever the press lit
+            LATCbits.LATC1 = 0;
+        }
+        else if((btn == BTN_ALARM) && (event == BTN_PRESS)){    //Alarm on/off
+            if(ringing){    //Silence it first
+                tone_stop();
+                i2c_write(RTC, 0x0F,0x00);
+                ringing = 0;
+            }
+            if(alarm ==0){  //Set alarm
+                i2c_write(RTC, 0x0E, 0x05);     //Enable interrupt
+                i2c_write(RTC, 0x0A, 0x80);     //Only check hours, minutes, seconds
+                alarm = 1;
+            }
+            else if(alarm ==1){   //Reset alarm
+                i2c_write(RTC, 0x0E, 0x04);     //Disable interrupt
+                alarm = 0;
+            }
+            LATAbits.LATA1 = 1;
+        }
+        else if((btn == BTN_ALARM) && (event == BTN_RELEASE)){
+            LATAbits.LATA1 = 0;
+        }
+    }
+    
+    //Remote sets the channel in set mode, events outside it are dropped so
+    //they do not pile up in the queue
+    int next = remote_channel(channel);
+    if(btn_down(BTN_MODE) && (next != channel)){
+        channel = next;
+        dac_wave(channel);
+    }
+}
+
+/*
+ * Display task. Set the selected time field from the potentiometer and
+ * redraw the time or the alarm.
+ */
+void task_display(){
+    if(btn_down(BTN_MODE)){   //Set mode
+        //Load adc values
+        value0 = adcRead0();   //Background unless ADC_READ says otherwise
+        
+        //Convert adc to time unit
+        int u24 = value0/42;    //24 unit
+        int u60 = value0/17;    //60 unit
+        
+        //Set value
+        switch((char)setNum){
+           case 1:
+               set_hours(u24);
+               break;
+           case 2:
+              set_minutes(u60);
+              break;
+           case 3:
+               set_seconds(u60);
+               break;
+           default:
+                break;
+       }
+        char array[2]; //Storage array
+        //Clear array
+        for(int i=0; i<2; i++){
+            array[i]=0;
+        }
+
+        lcd_char('T');
+        lcd_char(':');
+        lcd_char(' ');
+        //Print format HH/MM/SS
+        //Covert to char array
+        sprintf(array, "%u", get_hours());
+        char temp1 = array[0];   //Temporary storage
+        char temp2 = array[1];
+        if((temp1 != 0) && (temp2 != 0)){  //Check if not null
+            lcd_char(temp1);
+            lcd_char(temp2);
+        }
+        else if((temp1 != 0) && (temp2 == 0)){
+            lcd_char('0');
+            lcd_char(temp1); //Print digit
+        }
+        else{
+            lcd_char('0');
+            lcd_char('0');
+        }
+        lcd_char(':');
+        //Covert to char array
+        sprintf(array, "%u", get_minutes());
+        temp1 = array[0];   //Temporary storage
+        temp2 = array[1];
+        if((temp1 != 0) && (temp2 != 0)){  //Check if not null
+            lcd_char(temp1);
+            lcd_char(temp2);
+        }
+        else if((temp1 != 0) && (temp2 == 0)){
+            lcd_char('0');
+            lcd_char(temp1); //Print digit
+        }
+        else{
+            lcd_char('0');
+            lcd_char('0');
+        }
+        lcd_char(':');
+        //Covert to char array
+        sprintf(array, "%u", get_seconds());
+        temp1 = array[0];   //Temporary storage
+        temp2 = array[1];
+        if((temp1 != 0) && (temp2 != 0)){  //Check if not null
+            lcd_char(temp1);
+            lcd_char(temp2);
+        }
+        else if((temp1 != 0) && (temp2 == 0)){
+            lcd_char('0');
+            lcd_char(temp1); //Print digit
+        }
+        else{
+            lcd_char('0');
+            lcd_char('0');
+        }
+
+        //Alarm setting
+        lcd_char(' ');
+        lcd_char(' ');
+        lcd_char(' ');
+        if(alarm == 1){
+            lcd_char('A');
+            lcd_char('S');
+        }
+        else{
+            lcd_char('*');
+            lcd_char('*');
+        }
+        
+        //Covert to char array
+        sprintf(array, "%u", channel);
+        temp1 = array[0];   //Temporary storage
+        //Channel output
+        lcd_command(0xC0);  //Next row
+        
+        lcd_char('C');
+        lcd_char('H');
+        lcd_char(':');
+        lcd_char(' ');
+        if((temp1 != 0)){  //Check if not null
+            lcd_char(temp1);
+        }
+        else {
+            lcd_char('0');
+        }
+        
+        lcd_command(0x02);  //Clear Home
+    }
+    else{   //Alarm mode
+        if(check==0){
+            lcd_command(0x01);  //Clear Home
+            check++;
+        }
+        else if(check==1){
+            lcd_command(0x02);  //Clear Home
+            check--;
+        }
+        
+        //Load adc values
+        value0 = adcRead0();   //Background unless ADC_READ says otherwise
+
+        //Convert adc to time unit
+        int u24 = value0/42;    //24 unit
+        int u60 = value0/17;    //60 unit
+        
+        //Set value
+        switch((char)AsetNum){
+           case 1:
+               set_Ahours(u24);
+               break;
+           case 2:
+                set_Aminutes(u60);
+                break;
+           case 3:
+               set_Aseconds(u60);
+               break;
+           default:
+                break;
+       }
+        char array[2]; //Storage array
+        //Clear array
+        for(int i=0; i<2; i++){
+            array[i]=0;
+        }
+
+        lcd_char('A');
+        lcd_char(':');
+        lcd_char(' ');
+        //Print format HH/MM/SS
+        //Covert to char array
+        sprintf(array, "%u", get_Ahours());
+        char temp1 = array[0];   //Temporary storage
+        char temp2 = array[1];
+        if((temp1 != 0) && (temp2 != 0)){  //Check if not null
+            lcd_char(temp1);
+            lcd_char(temp2);
+        }
+        else if((temp1 != 0) && (temp2 == 0)){
+            lcd_char('0');
+            lcd_char(temp1); //Print digit
+        }
+        else{
+            lcd_char('0');
+            lcd_char('0');
+        }
+        lcd_char(':');
+        //Covert to char array
+        sprintf(array, "%u", get_Aminutes());
+        temp1 = array[0];   //Temporary storage
+        temp2 = array[1];
+        if((temp1 != 0) && (temp2 != 0)){  //Check if not null
+            lcd_char(temp1);
+            lcd_char(temp2);
+        }
+        else if((temp1 != 0) && (temp2 == 0)){
+            lcd_char('0');
+            lcd_char(temp1); //Print digit
+        }
+        else{
+            lcd_char('0');
+            lcd_char('0');
+        }
+        lcd_char(':');
+        //Covert to char array
+        sprintf(array, "%u", get_Aseconds());
+        temp1 = array[0];   //Temporary storage
+        temp2 = array[1];
+        if((temp1 != 0) && (temp2 != 0)){  //Check if not null
+            lcd_char(temp1);
+            lcd_char(temp2);
+        }
+        else if((temp1 != 0) && (temp2 == 0)){
+            lcd_char('0');
+            lcd_char(temp1); //Print digit
+        }
+        else{
+            lcd_char('0');
+            lcd_char('0');
+        }
+    }
+}
+
+/*
+ * RTC task. Start the alarm tone when the RTC alarm flag is up, the PWM plays
+ * it until the alarm button is pressed.
+ */
+void task_rtc(){
+    //Check for interrupt
+    if ((i2c_read(RTC, 0x0F)&0x01) == 1){
+        alarmON = 1;
+    }
+    else{
+        alarmON = 0;
+    }
+    
+    if(alarmON == 1 && alarm == 1 && !ringing){
+        tone_start();
+        ringing = 1;
+    }
+}
+
+/*
+ * Low priority interrupt, background ADC results, the button tick, the
+ * scheduler tick with the channel tone. The RTC INT pin
+ * going low runs the RTC task straight away instead of on its next second.
+ */
+void __interrupt(low_priority) ISR_low(){
+    adc_isr();
+    btn_isr();
+    if(PIR0bits.IOCIF && IOCAFbits.IOCAF5){
+        IOCAFbits.IOCAF5 = 0;
+        sched_wake(rtc_task);
+    }
+    if(sched_isr()){
+        dac_tick();     //Next channel tone sample
+    }
+}
 
 /*
  *
  */
 void main() {
-    int setNum=0;   //Switch case selection
-    int AsetNum=0;   //Alarm switch case selection
-    int alarm = 0;  //alarm flag
-    int check = 0;  //Check flag
-    int alarmON = 0;    //Speaker alarm on 
-    int channel=0;  //Channel number
-    
+    clock_init();   //4MHz until the first burst
     adc_init();     //Initialized ADC ports
     lcd_init();     //Initialize LCD screen, note this takes care of PORTC I/0 
                     //direction  
     i2c_init();     //Initialized i2c
     rtc_init();     //Initialized rtc
     spi_init();     //Initialized spi
+    tone_init();    //Alarm tone, off
     ccp_init();     //Initialize ccp
+    adc_start();    //Start background ADC
     
     TRISAbits.TRISA2 = 1;  //Configure PORTA pin 2 as input (switch1)
     TRISAbits.TRISA3 = 1;  //Configure PORTA pin 3 as input (button1)
@@ -70,329 +428,25 @@ void main() {
     TRISCbits.TRISC5 = 0;   //Configure PORTC pin 5 as output
     PORTCbits.RC5 = 0;  //Clear and enable
     
-    //Infinite loop to output the time. 
+    //RTC INT on RA5 wakes the CPU on its falling edge
+    IOCANbits.IOCAN5 = 1;
+    IOCAFbits.IOCAF5 = 0;
+    IPR0bits.IOCIP = 0;     //Low priority
+    PIE0bits.IOCIE = 1;
+    
+    btn_init();     //Start sampling the buttons
+    sched_init();   //Start the tick
+    
+    //Tasks, in priority order
+    sched_add(task_input, INPUT_MS);
+    sched_add(task_display, DISPLAY_MS);
+    rtc_task = sched_add(task_rtc, RTC_MS);
+    
+    //Infinite loop to run the tasks, idle until an interrupt when none ran
     while(1){        
-        if(PORTAbits.RA2==1){   //Set mode
-            //Load adc values
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
-            }
-            else{
-                value0 = ((value0+adcNum0())/2)+1;   //ADC average
-            }
-            
-            //Convert adc to time unit
-            int u24 = value0/42;    //24 unit
-            int u60 = value0/17;    //60 unit
-            
-            //Next selection
-            if(PORTAbits.RA3!=1){ 
-                setNum++;
-                if (setNum==4){
-                    setNum = 0;
-                }
-                //High to output
-                unsigned long num = 10000L;   //Delay
-                while (--num > 0) {  //Signal change will occur
-                        LATCbits.LATC0 =1;
-                }
-                if (setNum != 0){
-                    LATCbits.LATC0 =0;
-                }
-            }
-            //Set value
-            switch((char)setNum){
-               case 1:
-                   set_hours(u24);
-                   break;
-               case 2:
-                  set_minutes(u60);
-                  break;
-               case 3:
-                   set_seconds(u60);
-                   break;
-               default:
-                    break;
-           }
-            char array[2]; //Storage array
-            //Clear array
-            for(int i=0; i<2; i++){
-                array[i]=0;
-            }
-
-            lcd_char('T');
-            lcd_char(':');
-            lcd_char(' ');
-            //Print format HH/MM/SS
-            //Covert to char array
-            sprintf(array, "%u", get_hours());
-            char temp1 = array[0];   //Temporary storage
-            char temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%u", get_minutes());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%u", get_seconds());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-
-            //Alarm setting
-            lcd_char(' ');
-            lcd_char(' ');
-            lcd_char(' ');
-            if(alarm == 1){
-                lcd_char('A');
-                lcd_char('S');
-            }
-            else{
-                lcd_char('*');
-                lcd_char('*');
-            }
-            
-            //Set value
-           channel=getr();
-            
-            //Covert to char array
-            sprintf(array, "%u", channel);
-            temp1 = array[0];   //Temporary storage
-            //Channel output
-            lcd_command(0xC0);  //Next row
-            
-            lcd_char('C');
-            lcd_char('H');
-            lcd_char(':');
-            lcd_char(' ');
-            if((temp1 != 0)){  //Check if not null
-                lcd_char(temp1);
-            }
-            else {
-                lcd_char('0');
-            }
-            
-            lcd_command(0x02);  //Clear Home
-        }
-        else{   //Alarm mode
-            if(check==0){
-                lcd_command(0x01);  //Clear Home
-                check++;
-            }
-            else if(check==1){
-                lcd_command(0x02);  //Clear Home
-                check--;
-            }
-            
-            //Load adc values
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
-            }
-            else{
-                value0 = ((value0+adcNum0())/2)+1;   //ADC average
-            }
-
-            //Convert adc to time unit
-            int u24 = value0/42;    //24 unit
-            int u60 = value0/17;    //60 unit
-            
-            //Next selection
-            if(PORTAbits.RA3!=1){              
-                AsetNum++;
-                if (AsetNum==4){
-                    AsetNum = 0;
-                }
-                //High to output
-                unsigned long num = 10000L;   //Delay
-                while (--num > 0) {  //Signal change will occur
-                        LATCbits.LATC1 =1;
-                }
-                if (AsetNum != 0){
-                    LATCbits.LATC1 =0;
-                }
-            }
-            //Set value
-            switch((char)AsetNum){
-               case 1:
-                   set_Ahours(u24);
-                   break;
-               case 2:
-                    set_Aminutes(u60);
-                    break;
-               case 3:
-                   set_Aseconds(u60);
-                   break;
-               default:
-                    break;
-           }
-            char array[2]; //Storage array
-            //Clear array
-            for(int i=0; i<2; i++){
-                array[i]=0;
-            }
-
-            lcd_char('A');
-            lcd_char(':');
-            lcd_char(' ');
-            //Print format HH/MM/SS
-            //Covert to char array
-            sprintf(array, "%u", get_Ahours());
-            char temp1 = array[0];   //Temporary storage
-            char temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%u", get_Aminutes());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%u", get_Aseconds());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-        }
-        //Check for interrupt
-        if ((i2c_read(RTC, 0x0F)&0x01) == 1){
-            alarmON = 1;
-        }
-        else{
-            alarmON = 0;
-        }
-        
-        //Button trigger alarm
-        if (PORTAbits.RA4!=1){
-            if(alarm ==0){  //Set alarm
-                i2c_write(RTC, 0x0E, 0x05);     //Enable interrupt
-                i2c_write(RTC, 0x0A, 0x80);     //Only check hours, minutes, seconds
-                alarm = 1;
-            }
-            else if(alarm ==1){   //Reset alarm
-                i2c_write(RTC, 0x0E, 0x04);     //Disable interrupt
-                alarm = 0;
-            }
-            //High to output
-            unsigned long num = 10000L;   //Delay
-            while (--num > 0) {  //Signal change will occur
-                    LATAbits.LATA1 =1;
-            }
-            LATAbits.LATA1 =0;
-        }
-        
-        if(alarmON == 1 && alarm == 1){
-           while(PORTAbits.RA4==1){
-                //Speaker tone
-                LATCbits.LATC5=1;
-                __delay_ms(0.25);
-                LATCbits.LATC5=0;
-                __delay_ms(0.25);
-            }
-           i2c_write(RTC, 0x0F,0x00);
-        }
-        
-        //Channel DAC output
-        switch(channel){
-           case 0:
-               for(int y=0; y<2; y++){
-                    for (int x = 0; x < 50; x++){
-                         unsigned char volatile outv = (int)(sin[x]);     //Adjust to voltage
-                         spi_write(outv);
-                         __delay_ms(1);
-                    }
-               }
-               break;
-           case 1:
-               for(int y=0; y<2; y++){
-                    for (int x = 0; x < 50; x++){
-                         unsigned char volatile outv = (int)(triangle[x]);     //Adjust to voltage
-                         spi_write(outv);
-                         __delay_ms(1);
-                    }
-               }
-              break;
-           case 2:
-               for(int y=0; y<2; y++){
-                for (int x = 0; x < 50; x++){
-                     unsigned char volatile outv = (int)(sawtooth[x]);     //Adjust to voltage
-                     spi_write(outv);
-                     __delay_ms(1);
-                }
-               }
-               break;
-           default:
-                break;
+        if(!sched_run()){
+            sched_idle();
         }
     }
     return;
 }
-
@@ -4,6 +4,13 @@
  */
 #include "i2c.h"
 
+/*
+ * Set the baud rate divider for I2C_SCL at the active clock.
+ */
+void i2c_clock(){
+    SSP1ADD = (clock_hz()/(4*I2C_SCL))-1;   //SCL=FOSC/(4*(SSP1ADD+1))
+}
+
 /*
  * Initialization of I2C through PortC for the DS3231.
  */
@@ -21,7 +28,8 @@ void i2c_init(){
     RC3PPS = 0x0F;  //PPS SCL
     
     //Setup the I2C master clock.
-    SSP1ADD = 12;   //MSSP Baud Rate Divider    SCL=((n + 1) *4)/FOSC
+    i2c_clock();    //MSSP Baud Rate Divider
+    clock_add(i2c_clock);
 
     SSP1CON1bits.SSPM = 8;  //Clock=FOSC/(4*(SSPxADD+1))
     
@@ -8,8 +8,12 @@
 #include <xc.h>     //Contain the PIC C commands
 #include <stdio.h>
 #include <stdlib.h>
+#include "clock.h"
+
+#define I2C_SCL 100000UL    //SCL rate in Hz
 
 void i2c_init();  
+void i2c_clock();
 unsigned char i2c_read(unsigned char address, unsigned char registers);
 void i2c_write(unsigned char address, unsigned char registers, unsigned char data);
 
@@ -0,0 +1,205 @@
+/*
+ * IR decoder functions.
+ * Decodes NEC frames from the period between rising edges of the receiver and
+ * reports press, repeat and release events. No hardware access so the ISR only
+ * has to pass the captured periods in.
+ */
+#include "ir.h"
+
+//Decoder states
+#define IR_IDLE 0
+#define IR_DATA 1
+
+//Global Variables
+unsigned char ir_state = IR_IDLE;   //Decoder state
+unsigned char ir_bits = 0;  //Bits received in the current frame
+uint32_t ir_code = 0;   //Frame shift register, NEC sends LSB first
+unsigned char ir_key = IR_KEY_NONE;    //Key currently held
+unsigned char ir_frames = 0;    //Repeat frames since the last auto-repeat
+unsigned char ir_steps = 0;     //Auto-repeats of the current hold
+
+//Event queue, written from the ISR and read from the main loop
+unsigned char ir_qtype[IR_QUEUE];
+unsigned char ir_qkey[IR_QUEUE];
+volatile unsigned char ir_head = 0;
+volatile unsigned char ir_tail = 0;
+
+/*
+ * Add an event to the queue, dropped if the queue is full.
+ */
+void ir_push(unsigned char type, unsigned char key){
+    unsigned char next = (ir_head+1) & (IR_QUEUE-1);
+
+    if(next != ir_tail){
+        ir_qtype[ir_head] = type;
+        ir_qkey[ir_head] = key;
+        ir_head = next;
+    }
+}
+
+/*
+ * Map a NEC command to a key.
+ */
+unsigned char ir_lookup(unsigned char cmd){
+    switch(cmd){
+        case IR_CMD_CH_UP:
+            return IR_KEY_CH_UP;
+        case IR_CMD_CH_DOWN:
+            return IR_KEY_CH_DOWN;
+        case IR_CMD_0:
+            return IR_KEY_0;
+        case IR_CMD_1:
+            return IR_KEY_1;
+        case IR_CMD_2:
+            return IR_KEY_2;
+        default:
+            return IR_KEY_NONE;
+    }
+}
+
+/*
+ * Full frame received. Check the inverted command byte and report a press,
+ * releasing any key that was still held.
+ */
+void ir_frame(void){
+    unsigned char cmd = (ir_code >> 16) & 0xFF;
+    unsigned char inv = (ir_code >> 24) & 0xFF;
+
+    if((cmd ^ inv) != 0xFF){    //Corrupt frame
+        return;
+    }
+    if(ir_key != IR_KEY_NONE){
+        ir_push(IR_RELEASE, ir_key);
+    }
+    ir_key = ir_lookup(cmd);
+    ir_frames = 0;
+    ir_steps = 0;
+    if(ir_key != IR_KEY_NONE){
+        ir_push(IR_PRESS, ir_key);
+    }
+}
+
+/*
+ * Repeat frame received while a key is held. Only channel up/down auto-repeat,
+ * slow at first and then every frame once the hold has gone on long enough.
+ */
+void ir_repeat(void){
+    unsigned char need;     //Frames needed for the next step
+
+    if((ir_key != IR_KEY_CH_UP) && (ir_key != IR_KEY_CH_DOWN)){
+        return;
+    }
+    if(ir_steps == 0){
+        need = IR_REPEAT_DELAY;
+    }
+    else if(ir_steps <= IR_REPEAT_ACCEL){
+        need = IR_REPEAT_SLOW;
+    }
+    else{
+        need = IR_REPEAT_FAST;
+    }
+
+    if(++ir_frames >= need){
+        ir_frames = 0;
+        if(ir_steps < 255){
+            ir_steps++;
+        }
+        ir_push(IR_REPEAT, ir_key);
+    }
+}
+
+/*
+ * Reset the decoder and clear the event queue.
+ */
+void ir_init(void){
+    ir_state = IR_IDLE;
+    ir_bits = 0;
+    ir_code = 0;
+    ir_key = IR_KEY_NONE;
+    ir_frames = 0;
+    ir_steps = 0;
+    ir_head = 0;
+    ir_tail = 0;
+}
+
+/*
+ * Classify the period between two rising edges.
+ */
+unsigned char ir_classify(uint16_t period){
+    if((period >= IR_BIT0_MIN) && (period <= IR_BIT0_MAX)){
+        return IR_PULSE_BIT0;
+    }
+    if((period >= IR_BIT1_MIN) && (period <= IR_BIT1_MAX)){
+        return IR_PULSE_BIT1;
+    }
+    if((period >= IR_REPEAT_MIN) && (period <= IR_REPEAT_MAX)){
+        return IR_PULSE_REPEAT;
+    }
+    if((period >= IR_LEADER_MIN) && (period <= IR_LEADER_MAX)){
+        return IR_PULSE_LEADER;
+    }
+    return IR_PULSE_NOISE;
+}
+
+/*
+ * Feed the period since the previous rising edge to the decoder.
+ */
+void ir_edge(uint16_t period){
+    unsigned char pulse = ir_classify(period);
+
+    switch(pulse){
+        case IR_PULSE_LEADER:   //Start of a new frame
+            ir_state = IR_DATA;
+            ir_bits = 0;
+            ir_code = 0;
+            break;
+        case IR_PULSE_REPEAT:
+            ir_state = IR_IDLE;
+            if(ir_key != IR_KEY_NONE){
+                ir_repeat();
+            }
+            break;
+        case IR_PULSE_BIT0:
+        case IR_PULSE_BIT1:
+            if(ir_state == IR_DATA){
+                ir_code >>= 1;
+                if(pulse == IR_PULSE_BIT1){
+                    ir_code |= 0x80000000UL;
+                }
+                if(++ir_bits == 32){
+                    ir_state = IR_IDLE;
+                    ir_frame();
+                }
+            }
+            break;
+        default:    //Noise or the gap between frames
+            ir_state = IR_IDLE;
+            break;
+    }
+}
+
+/*
+ * No edge for a full Timer1 period, any held key has been released.
+ */
+void ir_timeout(void){
+    ir_state = IR_IDLE;
+    if(ir_key != IR_KEY_NONE){
+        ir_push(IR_RELEASE, ir_key);
+        ir_key = IR_KEY_NONE;
+    }
+}
+
+/*
+ * Get the next event, IR_NONE if there is none. The key is written to key.
+ */
+unsigned char ir_get_event(unsigned char *key){
+    unsigned char type;
+
+    if(ir_head == ir_tail){
+        return IR_NONE;
+    }
+    type = ir_qtype[ir_tail];
+    *key = ir_qkey[ir_tail];
+    ir_tail = (ir_tail+1) & (IR_QUEUE-1);
+    return type;
+}
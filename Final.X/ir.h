@@ -0,0 +1,62 @@
+/*
+ * Header for IR decoder functions.
+ */
+#ifndef IR_H
+#define	IR_H
+
+#include <stdint.h>
+
+//Pulse windows in Timer1 ticks (8us) between rising edges of the receiver
+#define IR_GAP 0xFFFF           //Edge after a Timer1 overflow (idle line)
+#define IR_LEADER_MIN 1520      //13.5ms NEC leader (9ms mark + 4.5ms space)
+#define IR_LEADER_MAX 1860
+#define IR_REPEAT_MIN 1270      //11.25ms NEC repeat (9ms mark + 2.25ms space)
+#define IR_REPEAT_MAX 1519
+#define IR_BIT1_MIN 211         //2.25ms logic 1
+#define IR_BIT1_MAX 350
+#define IR_BIT0_MIN 100         //1.125ms logic 0
+#define IR_BIT0_MAX 210
+
+//Pulse classes
+#define IR_PULSE_NOISE 0
+#define IR_PULSE_BIT0 1
+#define IR_PULSE_BIT1 2
+#define IR_PULSE_REPEAT 3
+#define IR_PULSE_LEADER 4
+
+//Events
+#define IR_NONE 0
+#define IR_PRESS 1
+#define IR_REPEAT 2
+#define IR_RELEASE 3
+
+//Keys
+#define IR_KEY_NONE 0
+#define IR_KEY_CH_UP 1
+#define IR_KEY_CH_DOWN 2
+#define IR_KEY_0 3
+#define IR_KEY_1 4
+#define IR_KEY_2 5
+
+//NEC command codes of the remote
+#define IR_CMD_CH_UP 0x47
+#define IR_CMD_CH_DOWN 0x45
+#define IR_CMD_0 0x16
+#define IR_CMD_1 0x0C
+#define IR_CMD_2 0x18
+
+//Auto-repeat for held channel up/down, counted in repeat frames (~108ms)
+#define IR_REPEAT_DELAY 4       //Frames before the first auto-repeat
+#define IR_REPEAT_SLOW 3        //Frames per step before acceleration
+#define IR_REPEAT_FAST 1        //Frames per step after acceleration
+#define IR_REPEAT_ACCEL 4       //Slow steps before switching to fast
+
+#define IR_QUEUE 8  //Event queue size, power of 2
+
+void ir_init(void);
+unsigned char ir_classify(uint16_t period);
+void ir_edge(uint16_t period);
+void ir_timeout(void);
+unsigned char ir_get_event(unsigned char *key);
+
+#endif	/* IR_H */
@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=final_main.c ../timer.X/adc.c ../timer.X/i2c.c ../timer.X/lcd.c timer.c dac.c ccp.c
+SOURCEFILES_QUOTED_IF_SPACED=final_main.c ../timer.X/adc.c ../timer.X/i2c.c ../timer.X/lcd.c timer.c dac.c ccp.c ir.c ../timer.X/btn.c sched.c ../timer.X/clock.c ../timer.X/tone.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/final_main.p1 ${OBJECTDIR}/_ext/1300550304/adc.p1 ${OBJECTDIR}/_ext/1300550304/i2c.p1 ${OBJECTDIR}/_ext/1300550304/lcd.p1 ${OBJECTDIR}/timer.p1 ${OBJECTDIR}/dac.p1 ${OBJECTDIR}/ccp.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/final_main.p1.d ${OBJECTDIR}/_ext/1300550304/adc.p1.d ${OBJECTDIR}/_ext/1300550304/i2c.p1.d ${OBJECTDIR}/_ext/1300550304/lcd.p1.d ${OBJECTDIR}/timer.p1.d ${OBJECTDIR}/dac.p1.d ${OBJECTDIR}/ccp.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/final_main.p1 ${OBJECTDIR}/_ext/1300550304/adc.p1 ${OBJECTDIR}/_ext/1300550304/i2c.p1 ${OBJECTDIR}/_ext/1300550304/lcd.p1 ${OBJECTDIR}/timer.p1 ${OBJECTDIR}/dac.p1 ${OBJECTDIR}/ccp.p1 ${OBJECTDIR}/ir.p1 ${OBJECTDIR}/_ext/1300550304/btn.p1 ${OBJECTDIR}/sched.p1 ${OBJECTDIR}/_ext/1300550304/clock.p1 ${OBJECTDIR}/_ext/1300550304/tone.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/final_main.p1.d ${OBJECTDIR}/_ext/1300550304/adc.p1.d ${OBJECTDIR}/_ext/1300550304/i2c.p1.d ${OBJECTDIR}/_ext/1300550304/lcd.p1.d ${OBJECTDIR}/timer.p1.d ${OBJECTDIR}/dac.p1.d ${OBJECTDIR}/ccp.p1.d ${OBJECTDIR}/ir.p1.d ${OBJECTDIR}/_ext/1300550304/btn.p1.d ${OBJECTDIR}/sched.p1.d ${OBJECTDIR}/_ext/1300550304/clock.p1.d ${OBJECTDIR}/_ext/1300550304/tone.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/final_main.p1 ${OBJECTDIR}/_ext/1300550304/adc.p1 ${OBJECTDIR}/_ext/1300550304/i2c.p1 ${OBJECTDIR}/_ext/1300550304/lcd.p1 ${OBJECTDIR}/timer.p1 ${OBJECTDIR}/dac.p1 ${OBJECTDIR}/ccp.p1
+OBJECTFILES=${OBJECTDIR}/final_main.p1 ${OBJECTDIR}/_ext/1300550304/adc.p1 ${OBJECTDIR}/_ext/1300550304/i2c.p1 ${OBJECTDIR}/_ext/1300550304/lcd.p1 ${OBJECTDIR}/timer.p1 ${OBJECTDIR}/dac.p1 ${OBJECTDIR}/ccp.p1 ${OBJECTDIR}/ir.p1 ${OBJECTDIR}/_ext/1300550304/btn.p1 ${OBJECTDIR}/sched.p1 ${OBJECTDIR}/_ext/1300550304/clock.p1 ${OBJECTDIR}/_ext/1300550304/tone.p1
 
 # Source Files
-SOURCEFILES=final_main.c ../timer.X/adc.c ../timer.X/i2c.c ../timer.X/lcd.c timer.c dac.c ccp.c
+SOURCEFILES=final_main.c ../timer.X/adc.c ../timer.X/i2c.c ../timer.X/lcd.c timer.c dac.c ccp.c ir.c ../timer.X/btn.c sched.c ../timer.X/clock.c ../timer.X/tone.c
 
 
 
@@ -110,6 +110,30 @@ ${OBJECTDIR}/_ext/1300550304/adc.p1: ../timer.X/adc.c  nbproject/Makefile-${CND_
 	@-${MV} ${OBJECTDIR}/_ext/1300550304/adc.d ${OBJECTDIR}/_ext/1300550304/adc.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/adc.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1300550304/clock.p1: ../timer.X/clock.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/clock.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/clock.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1300550304/clock.p1 ../timer.X/clock.c 
+	@-${MV} ${OBJECTDIR}/_ext/1300550304/clock.d ${OBJECTDIR}/_ext/1300550304/clock.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/clock.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1300550304/btn.p1: ../timer.X/btn.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/btn.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/btn.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1300550304/btn.p1 ../timer.X/btn.c 
+	@-${MV} ${OBJECTDIR}/_ext/1300550304/btn.d ${OBJECTDIR}/_ext/1300550304/btn.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/btn.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1300550304/tone.p1: ../timer.X/tone.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/tone.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/tone.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1300550304/tone.p1 ../timer.X/tone.c 
+	@-${MV} ${OBJECTDIR}/_ext/1300550304/tone.d ${OBJECTDIR}/_ext/1300550304/tone.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/tone.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1300550304/i2c.p1: ../timer.X/i2c.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
 	@${RM} ${OBJECTDIR}/_ext/1300550304/i2c.p1.d 
@@ -150,6 +174,22 @@ ${OBJECTDIR}/ccp.p1: ccp.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/ccp.d ${OBJECTDIR}/ccp.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/ccp.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/ir.p1: ir.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ir.p1.d 
+	@${RM} ${OBJECTDIR}/ir.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/ir.p1 ir.c 
+	@-${MV} ${OBJECTDIR}/ir.d ${OBJECTDIR}/ir.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/ir.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/sched.p1: sched.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/sched.p1.d 
+	@${RM} ${OBJECTDIR}/sched.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/sched.p1 sched.c 
+	@-${MV} ${OBJECTDIR}/sched.d ${OBJECTDIR}/sched.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/sched.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 else
 ${OBJECTDIR}/final_main.p1: final_main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
@@ -167,6 +207,30 @@ ${OBJECTDIR}/_ext/1300550304/adc.p1: ../timer.X/adc.c  nbproject/Makefile-${CND_
 	@-${MV} ${OBJECTDIR}/_ext/1300550304/adc.d ${OBJECTDIR}/_ext/1300550304/adc.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/adc.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1300550304/clock.p1: ../timer.X/clock.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/clock.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/clock.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1300550304/clock.p1 ../timer.X/clock.c 
+	@-${MV} ${OBJECTDIR}/_ext/1300550304/clock.d ${OBJECTDIR}/_ext/1300550304/clock.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/clock.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1300550304/btn.p1: ../timer.X/btn.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/btn.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/btn.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1300550304/btn.p1 ../timer.X/btn.c 
+	@-${MV} ${OBJECTDIR}/_ext/1300550304/btn.d ${OBJECTDIR}/_ext/1300550304/btn.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/btn.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1300550304/tone.p1: ../timer.X/tone.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/tone.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1300550304/tone.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/_ext/1300550304/tone.p1 ../timer.X/tone.c 
+	@-${MV} ${OBJECTDIR}/_ext/1300550304/tone.d ${OBJECTDIR}/_ext/1300550304/tone.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1300550304/tone.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 ${OBJECTDIR}/_ext/1300550304/i2c.p1: ../timer.X/i2c.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/1300550304" 
 	@${RM} ${OBJECTDIR}/_ext/1300550304/i2c.p1.d 
@@ -207,6 +271,22 @@ ${OBJECTDIR}/ccp.p1: ccp.c  nbproject/Makefile-${CND_CONF}.mk
 	@-${MV} ${OBJECTDIR}/ccp.d ${OBJECTDIR}/ccp.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/ccp.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/ir.p1: ir.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/ir.p1.d 
+	@${RM} ${OBJECTDIR}/ir.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/ir.p1 ir.c 
+	@-${MV} ${OBJECTDIR}/ir.d ${OBJECTDIR}/ir.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/ir.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/sched.p1: sched.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/sched.p1.d 
+	@${RM} ${OBJECTDIR}/sched.p1 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c    -fno-short-double -fno-short-float -memi=wordwrite -O0 -fasmfile -maddrqual=ignore -xassembler-with-cpp -mwarn=-3 -Wa,-a -DXPRJ_default=$(CND_CONF)  -msummary=-psect,-class,+mem,-hex,-file -merrata=+NVMREG  -ginhx032 -Wl,--data-init -mno-keep-startup -mno-download -mdefault-config-bits $(COMPARISON_BUILD)  -std=c99 -gdwarf-3 -mstack=compiled:auto:auto:auto     -o ${OBJECTDIR}/sched.p1 sched.c 
+	@-${MV} ${OBJECTDIR}/sched.d ${OBJECTDIR}/sched.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/sched.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 endif
 
 # ------------------------------------------------------------------------------------
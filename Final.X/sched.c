@@ -0,0 +1,274 @@
+/*
+ * Scheduler functions.
+ * Cooperative, every task runs to completion from the main loop once its
+ * period in 1ms ticks has passed. Timer0 makes the tick and Timer3 runs free
+ * at 0.5us at either clock to time each run, runs past its 32ms wrap are
+ * timed in ticks. A task that starts a full period late, or runs for longer
+ * than its period, counts an overrun and the missed runs are dropped.
+ * With nothing due the CPU idles or dozes until the next interrupt, every
+ * wake source is an interrupt (tick, capture, buttons, ADC, RTC INT). With
+ * SCHED_BURST the tasks run at the fast clock and the CPU idles at the slow.
+ */
+#include "sched.h"
+
+//Task table
+void (*sched_task[SCHED_TASKS])(void);
+uint16_t sched_period[SCHED_TASKS];     //Ticks between runs
+uint16_t sched_due[SCHED_TASKS];    //Tick of the next run
+uint32_t sched_last[SCHED_TASKS];   //Last run time in us
+uint32_t sched_worst[SCHED_TASKS];  //Longest run time in us
+uint16_t sched_over[SCHED_TASKS];   //Overruns
+uint16_t sched_lat[SCHED_TASKS];    //Longest tick to start in us
+volatile unsigned char sched_flag[SCHED_TASKS];     //Run now, set from an ISR
+unsigned char sched_count = 0;  //Tasks added
+
+volatile uint16_t sched_ticks = 0;  //1ms ticks, wraps
+volatile uint16_t sched_stamp = 0;  //Timer3 at the last tick or wake
+volatile unsigned char sched_pending = 0;   //Tick or wake since the last run
+
+//Load measurement
+uint32_t sched_idle_us = 0;     //Idle time in this window
+uint16_t sched_window = 0;  //Tick the window started
+unsigned char sched_busy = 100;     //Percent busy in the last window
+
+/*
+ * Timer dividers for the active clock. Timer3 runs from FOSC at the slow clock
+ * so it counts at 2MHz at both.
+ */
+void sched_clock(){
+    T0CON1bits.T0CKPS = 0b0010+clock_shift();   //1:4 at 4MHz
+    if(clock_shift()){
+        TMR3CLKbits.CS = 1;     //FOSC/4
+        T3CONbits.CKPS = 3;     //1:8
+    }
+    else{
+        TMR3CLKbits.CS = 2;     //FOSC
+        T3CONbits.CKPS = 1;     //1:2
+    }
+}
+
+/*
+ * Configures Timer0 as the 1ms tick on the low priority interrupt and Timer3
+ * as the run time clock.
+ */
+void sched_init(){
+    //Timer0 setup
+    T0CON0 = 0x00;  //8-bit, 1:1 postscaler
+    T0CON1bits.T0CS = 0b010;    //FOSC/4
+    T0CON1bits.T0ASYNC = 0;
+    TMR0H = SCHED_PR;   //Period in 8-bit mode
+    TMR0L = 0;
+    T0CON0bits.T0EN = 1;
+    
+    //Timer3 setup
+    TMR3 = 0;
+    T3CONbits.RD16 = 1;
+    sched_clock();
+    T3CONbits.ON = 1;
+    clock_add(sched_clock);
+    
+    //Interrupt enable
+    INTCONbits.IPEN = 1;
+    IPR0bits.TMR0IP = 0;
+    PIR0bits.TMR0IF = 0;
+    PIE0bits.TMR0IE = 1;
+    GIEL = 1;
+    GIEH = 1;
+}
+
+/*
+ * Add a task that runs every period ticks, first run one period from now.
+ * Returns the task slot for the statistics.
+ */
+unsigned char sched_add(void (*task)(void), uint16_t period){
+    unsigned char i = sched_count;
+    
+    if(i >= SCHED_TASKS){
+        return 0xFF;
+    }
+    sched_task[i] = task;
+    sched_period[i] = period;
+    sched_due[i] = sched_now()+period;
+    sched_last[i] = 0;
+    sched_worst[i] = 0;
+    sched_over[i] = 0;
+    sched_lat[i] = 0;
+    sched_flag[i] = 0;
+    sched_count++;
+    return i;
+}
+
+/*
+ * Called from the low priority interrupt, returns 1 on a tick.
+ */
+unsigned char sched_isr(){
+    if(PIR0bits.TMR0IF){
+        PIR0bits.TMR0IF = 0;
+        sched_ticks++;
+        sched_stamp = TMR3;
+        sched_pending = 1;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Current tick without the ISR in the middle.
+ */
+uint16_t sched_now(){
+    uint16_t now;
+    
+    GIEL = 0;
+    now = sched_ticks;
+    GIEL = 1;
+    return now;
+}
+
+/*
+ * Called from an ISR to run task i on the next pass.
+ */
+void sched_wake(unsigned char i){
+    sched_flag[i] = 1;
+    sched_stamp = TMR3;
+    sched_pending = 1;
+}
+
+/*
+ * Run every task that is due once, in table order. Returns the number of
+ * tasks run.
+ */
+unsigned char sched_run(){
+    unsigned char ran = 0;
+    sched_pending = 0;
+    uint16_t now = sched_now();
+    
+    for(unsigned char i=0; i<sched_count; i++){
+        uint16_t late = now-sched_due[i];
+        
+        if(sched_flag[i]){  //Woken, runs now and keeps its period
+            sched_flag[i] = 0;
+            late = 0;
+        }
+        else if(late >= 0x8000){     //Not due yet
+            continue;
+        }
+        else{
+            //Missed a whole period, skip ahead
+            if(late >= sched_period[i]){
+                sched_over[i]++;
+                sched_due[i] += (late/sched_period[i])*sched_period[i];
+            }
+            sched_due[i] += sched_period[i];
+        }
+        
+        if(SCHED_BURST){    //No-op after the first task
+            clock_set(CLOCK_FAST);
+        }
+        
+        uint16_t tick = sched_now();
+        uint16_t start = TMR3;
+        if(late == 0){  //Due on the last tick, time the response
+            GIEL = 0;
+            uint16_t lat = SCHED_US((uint16_t)(start-sched_stamp));
+            GIEL = 1;
+            if(lat > sched_lat[i]){
+                sched_lat[i] = lat;
+            }
+        }
+        sched_task[i]();
+        
+        //Timer3 wraps every 32ms, longer runs are timed in ticks
+        uint32_t run = SCHED_US((uint16_t)(TMR3-start));
+        uint16_t ticks = sched_now()-tick;
+        if(ticks >= SCHED_LONG){
+            run = ticks*1000UL;
+        }
+        
+        sched_last[i] = run;
+        if(run > sched_worst[i]){
+            sched_worst[i] = run;
+        }
+        if(run >= sched_period[i]*1000UL){  //Ran over its own period
+            sched_over[i]++;
+        }
+        ran++;
+    }
+    
+    //Busy percent over the window
+    if((uint16_t)(now-sched_window) >= SCHED_WINDOW){
+        sched_busy = 100-(sched_idle_us/(SCHED_WINDOW*10UL));
+        sched_idle_us = 0;
+        sched_window = now;
+    }
+    return ran;
+}
+
+/*
+ * Nothing due, wait for the next interrupt the way SCHED_POWER selects. Idle
+ * keeps every peripheral clock running so Timer1 capture and the ticks are
+ * unaffected, and the core is back one instruction after the wake. The
+ * low priority interrupts are held off around the check so a tick just before
+ * SLEEP still wakes it, the ISR then runs once GIEL is set again.
+ */
+void sched_idle(){
+    if(SCHED_BURST){
+        clock_set(CLOCK_SLOW);
+    }
+    uint16_t start = TMR3;
+    
+    if(SCHED_POWER == SCHED_IDLE){
+        CPUDOZEbits.IDLEN = 1;  //SLEEP enters Idle
+        GIEL = 0;
+        if(!sched_pending){
+            SLEEP();
+            NOP();
+        }
+        GIEL = 1;
+    }
+    else if(SCHED_POWER == SCHED_DOZE){
+        CPUDOZE = 0x00;
+        CPUDOZEbits.DOZE = 0b010;   //1:8
+        CPUDOZEbits.ROI = 1;    //Interrupt ends Doze, ISR at full speed
+        CPUDOZEbits.DOZEN = 1;
+        while(CPUDOZEbits.DOZEN && !sched_pending){};
+        CPUDOZE = 0x00;     //Full speed for the tasks, no Doze on exit
+    }
+    
+    sched_idle_us += SCHED_US((uint16_t)(TMR3-start));
+}
+
+/*
+ * Last run time of task i in us.
+ */
+uint32_t sched_time(unsigned char i){
+    return sched_last[i];
+}
+
+/*
+ * Longest run time of task i in us.
+ */
+uint32_t sched_max(unsigned char i){
+    return sched_worst[i];
+}
+
+/*
+ * Overruns of task i.
+ */
+uint16_t sched_overruns(unsigned char i){
+    return sched_over[i];
+}
+
+/*
+ * Longest time from the tick or wake to the start of task i in us.
+ */
+uint16_t sched_latency(unsigned char i){
+    return sched_lat[i];
+}
+
+/*
+ * Percent of the last window the CPU was not idle. Average current is about
+ * I_idle+load*(I_run-I_idle) for the SCHED_POWER mode.
+ */
+unsigned char sched_load(){
+    return sched_busy;
+}
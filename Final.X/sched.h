@@ -0,0 +1,39 @@
+/*
+ * Header for scheduler functions.
+ */
+#ifndef SCHED_H
+#define	SCHED_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+#include "clock.h"
+
+#define SCHED_TASKS 4   //Task slots
+#define SCHED_PR 249    //Timer0 period, 1MHz/4/250 = 1ms tick
+#define SCHED_WINDOW 1000   //Ticks per load measurement
+
+//What the CPU does with no task due
+#define SCHED_RUN 0     //Spin
+#define SCHED_IDLE 1    //Idle, core stopped and peripherals clocked
+#define SCHED_DOZE 2    //Doze, core at 1/8 until an interrupt
+#define SCHED_POWER SCHED_IDLE
+#define SCHED_BURST 1   //Run the tasks at the fast clock, idle at the slow
+
+#define SCHED_US(t) ((t) >> 1)  //Timer3 counts to us
+#define SCHED_LONG 16   //Ticks from which a run is timed in ticks, not Timer3
+
+void sched_init();
+void sched_clock();
+unsigned char sched_add(void (*task)(void), uint16_t period);
+unsigned char sched_isr();
+uint16_t sched_now();
+unsigned char sched_run();
+void sched_idle();
+void sched_wake(unsigned char i);
+uint32_t sched_time(unsigned char i);
+uint32_t sched_max(unsigned char i);
+uint16_t sched_overruns(unsigned char i);
+uint16_t sched_latency(unsigned char i);
+unsigned char sched_load();
+
+#endif	/* SCHED_H */
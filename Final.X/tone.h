@@ -0,0 +1,20 @@
+/*
+ * Header for alarm tone functions.
+ */
+#ifndef TONE_H
+#define	TONE_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+#include "clock.h"
+
+#define TONE_PR 124     //Timer6 period, 1MHz/4/125 = 2kHz
+#define TONE_DUTY 250   //CCPR2 for 50%, half of 4*(TONE_PR+1)
+#define TONE_PPS 0x06   //RC5PPS value of the CCP2 output
+
+void tone_init();
+void tone_clock();
+void tone_start();
+void tone_stop();
+
+#endif	/* TONE_H */
@@ -0,0 +1,475 @@
+/*
+ * File:   replay.c
+ * Description:
+ * Host build of the Final.X IR decoder (ir.c) for replaying edge timestamps
+ * without the hardware. Edges come from a test.X capture dump, a text file or
+ * the built in NEC generator. The decoder is fed exactly like the Final.X ISR
+ * does: the period between rising edges in 8us Timer1 ticks, IR_GAP after a
+ * Timer1 overflow and ir_timeout() on the overflow itself.
+ *
+ * Text format, one item per line:
+ * # comment
+ * <us>                 Rising edge timestamp
+ * = <event> <key>      Expected event, press/repeat/release and key number
+ *
+ * Usage:
+ * replay [-n passes] [-w out.txt] file         Replay a capture or text file
+ * replay [-n passes] [-w out.txt] [-j pct] -s N
+ *                                              Replay N generated key presses
+ *                                              with pct percent jitter
+ *
+ * Reports the events against the expected ones, frames and edges per second
+ * and the mean and worst cost of one ir_edge() call.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+//Includes files
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define COST_UNIT "cycles"
+#define cost_now() __rdtsc()
+#else
+#define COST_UNIT "ns"
+#define cost_now() now_ns()
+#endif
+#include "ir.h"
+
+#define TICK_US 8   //Final.X Timer1 tick, FOSC/4 with 1:8 prescaler
+#define OVERFLOW_US (65536UL*TICK_US)   //Timer1 overflow period
+#define CAP_SYNC 0xA5   //test.X frame sync
+#define COST_PASSES 5   //Timed passes for the per edge cost
+
+//Edge and event lists
+uint32_t *edges = NULL;
+size_t nedges = 0;
+size_t cedges = 0;
+unsigned char *expect = NULL;  //Pairs of event and key
+size_t nexpect = 0;
+size_t cexpect = 0;
+unsigned char *got = NULL;
+size_t ngot = 0;
+size_t cgot = 0;
+size_t nframes = 0;     //Leader and repeat frames seen
+
+const char *names[] = {"none", "press", "repeat", "release"};
+
+/*
+ * Monotonic time in ns.
+ */
+uint64_t now_ns(void){
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * Append to the growing edge and event lists.
+ */
+void add_edge(uint32_t t){
+    if(nedges == cedges){
+        cedges = cedges ? cedges*2 : 1024;
+        edges = realloc(edges, cedges*sizeof(*edges));
+    }
+    edges[nedges++] = t;
+}
+
+void add_event(unsigned char **list, size_t *n, size_t *cap,
+        unsigned char type, unsigned char key){
+    if(*n+2 > *cap){
+        *cap = *cap ? *cap*2 : 256;
+        *list = realloc(*list, *cap);
+    }
+    (*list)[(*n)++] = type;
+    (*list)[(*n)++] = key;
+}
+
+/*
+ * Read a test.X capture dump. Only the rising edges are kept, the flags of
+ * each frame give the level after its first edge.
+ */
+int load_dump(FILE *fp){
+    int c;
+    size_t bad = 0;
+
+    while((c = fgetc(fp)) != EOF){
+        if(c != CAP_SYNC){
+            continue;
+        }
+        unsigned char hdr[6];
+        if(fread(hdr, 1, 6, fp) != 6){
+            break;
+        }
+        unsigned char check = 0;
+        for(int i=0; i<6; i++){
+            check ^= hdr[i];
+        }
+        unsigned n = hdr[0];
+        unsigned rising = hdr[1] & 0x01;
+        uint32_t t = hdr[2] | (hdr[3] << 8) | ((uint32_t)hdr[4] << 16)
+                | ((uint32_t)hdr[5] << 24);
+        uint32_t *frame = malloc((n ? n : 1)*sizeof(*frame));
+        frame[0] = t;
+        int ok = 1;
+        for(unsigned i=1; (i<n) && ok; i++){
+            uint32_t d = 0;
+            int shift = 0;
+            do{
+                c = fgetc(fp);
+                if(c == EOF){
+                    ok = 0;
+                    break;
+                }
+                check ^= c;
+                d |= (uint32_t)(c & 0x7F) << shift;
+                shift += 7;
+            }while(c & 0x80);
+            t += d;
+            frame[i] = t;
+        }
+        c = fgetc(fp);
+        if(!ok || (c == EOF) || ((check ^ c) != 0)){
+            bad++;
+        }
+        else{
+            for(unsigned i=(rising ? 0 : 1); i<n; i+=2){
+                add_edge(frame[i]);
+            }
+        }
+        free(frame);
+    }
+    if(bad){
+        fprintf(stderr, "%zu corrupt capture frames skipped\n", bad);
+    }
+    return 0;
+}
+
+/*
+ * Read a text file of rising edges and expected events.
+ */
+int load_text(FILE *fp){
+    char line[128];
+    char ev[16];
+    unsigned key;
+
+    while(fgets(line, sizeof(line), fp)){
+        if(line[0] == '#' || line[0] == '\n'){
+            continue;
+        }
+        if(line[0] == '='){
+            if(sscanf(line+1, "%15s %u", ev, &key) != 2){
+                return -1;
+            }
+            unsigned char type = IR_NONE;
+            for(unsigned char i=IR_PRESS; i<=IR_RELEASE; i++){
+                if(strcmp(ev, names[i]) == 0){
+                    type = i;
+                }
+            }
+            if(type == IR_NONE){
+                return -1;
+            }
+            add_event(&expect, &nexpect, &cexpect, type, key);
+        }
+        else{
+            add_edge(strtoul(line, NULL, 10));
+        }
+    }
+    return 0;
+}
+
+/*
+ * Spread a nominal time by up to pct percent either way.
+ */
+uint32_t jitter(uint32_t us, int pct){
+    if(pct == 0){
+        return us;
+    }
+    int span = (int)us*pct/100;
+    return us - span + rand()%(2*span+1);
+}
+
+/*
+ * Add one NEC frame or repeat frame starting at t. Returns the timestamp of
+ * the last edge.
+ */
+uint32_t gen_frame(uint32_t t, unsigned char cmd, int pct){
+    uint32_t code = 0x00FF | ((uint32_t)cmd << 16)
+            | ((uint32_t)(~cmd & 0xFF) << 24);
+
+    add_edge(t);
+    t += jitter(13500, pct);    //Leader
+    add_edge(t);
+    for(int i=0; i<32; i++){
+        t += jitter(((code >> i) & 1) ? 2250 : 1125, pct);
+        add_edge(t);
+    }
+    return t;
+}
+
+uint32_t gen_repeat(uint32_t t, int pct){
+    add_edge(t);
+    t += jitter(11250, pct);
+    add_edge(t);
+    return t;
+}
+
+/*
+ * Generate presses of random keys with their expected events. Channel up and
+ * down follow the auto-repeat schedule of ir.h.
+ */
+void generate(int presses, int pct){
+    const unsigned char cmds[] = {IR_CMD_CH_UP, IR_CMD_CH_DOWN, IR_CMD_0,
+            IR_CMD_1, IR_CMD_2, 0x40};
+    const unsigned char keys[] = {IR_KEY_CH_UP, IR_KEY_CH_DOWN, IR_KEY_0,
+            IR_KEY_1, IR_KEY_2, IR_KEY_NONE};
+    uint32_t t = 1000000;
+    unsigned char held = IR_KEY_NONE;
+
+    for(int p=0; p<presses; p++){
+        int k = rand()%6;
+        int repeats = rand()%4 ? rand()%40 : 0;
+        uint32_t start = t;
+
+        if(held != IR_KEY_NONE){    //New frame ends the previous hold
+            add_event(&expect, &nexpect, &cexpect, IR_RELEASE, held);
+        }
+        held = keys[k];
+        gen_frame(t, cmds[k], pct);
+        if(held != IR_KEY_NONE){
+            add_event(&expect, &nexpect, &cexpect, IR_PRESS, held);
+        }
+
+        unsigned frames = 0;
+        unsigned steps = 0;
+        for(int r=0; r<repeats; r++){
+            start += 108000;
+            gen_repeat(start, pct);
+            if((held != IR_KEY_CH_UP) && (held != IR_KEY_CH_DOWN)){
+                continue;
+            }
+            unsigned need = (steps == 0) ? IR_REPEAT_DELAY
+                    : (steps <= IR_REPEAT_ACCEL) ? IR_REPEAT_SLOW
+                    : IR_REPEAT_FAST;
+            if(++frames >= need){
+                frames = 0;
+                steps++;
+                add_event(&expect, &nexpect, &cexpect, IR_REPEAT, held);
+            }
+        }
+
+        if(rand()%3){   //Let go long enough for the Timer1 overflow
+            t = start + 108000 + OVERFLOW_US + rand()%500000;
+            if(held != IR_KEY_NONE){
+                add_event(&expect, &nexpect, &cexpect, IR_RELEASE, held);
+            }
+            held = IR_KEY_NONE;
+        }
+        else{   //Next key straight away
+            t = start + 108000;
+        }
+    }
+    if(held != IR_KEY_NONE){    //Released at the end of the stream
+        add_event(&expect, &nexpect, &cexpect, IR_RELEASE, held);
+    }
+}
+
+/*
+ * Write the edges and expected events as a text file.
+ */
+void save_text(const char *path){
+    FILE *fp = fopen(path, "w");
+
+    if(fp == NULL){
+        perror(path);
+        exit(1);
+    }
+    fprintf(fp, "# Rising edges in us, expected events\n");
+    for(size_t i=0; i<nedges; i++){
+        fprintf(fp, "%lu\n", (unsigned long)edges[i]);
+    }
+    for(size_t i=0; i<nexpect; i+=2){
+        fprintf(fp, "= %s %u\n", names[expect[i]], expect[i+1]);
+    }
+    fclose(fp);
+}
+
+/*
+ * Collect the decoder events.
+ */
+void drain(int record){
+    unsigned char key;
+    unsigned char type;
+
+    while((type = ir_get_event(&key)) != IR_NONE){
+        if(record){
+            add_event(&got, &ngot, &cgot, type, key);
+        }
+    }
+}
+
+/*
+ * One pass over the edges the way the Final.X ISR sees them. With cost set,
+ * each ir_edge() call is timed and the lowest cost seen for each edge kept,
+ * so preemption by the host does not show up as decoder cost.
+ */
+void replay(int record, uint64_t *cost){
+    ir_init();
+    for(size_t i=0; i<nedges; i++){
+        uint32_t d = i ? edges[i]-edges[i-1] : OVERFLOW_US;
+        uint16_t period;
+
+        if(d >= OVERFLOW_US){   //Timer1 overflowed before this edge
+            ir_timeout();
+            period = IR_GAP;
+        }
+        else{
+            period = d/TICK_US;
+        }
+        if(record){
+            unsigned char pulse = ir_classify(period);
+            if((pulse == IR_PULSE_LEADER) || (pulse == IR_PULSE_REPEAT)){
+                nframes++;
+            }
+        }
+
+        if(cost){
+            uint64_t c0 = cost_now();
+            ir_edge(period);
+            uint64_t c = cost_now() - c0;
+            if(c < cost[i]){
+                cost[i] = c;
+            }
+        }
+        else{
+            ir_edge(period);
+        }
+        drain(record);
+    }
+    ir_timeout();   //Line idle at the end
+    drain(record);
+}
+
+int main(int argc, char **argv){
+    int passes = 200;
+    int presses = 0;
+    int pct = 3;
+    const char *out = NULL;
+    const char *in = NULL;
+
+    for(int i=1; i<argc; i++){
+        if(strcmp(argv[i], "-n") == 0 && i+1 < argc){
+            passes = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-s") == 0 && i+1 < argc){
+            presses = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-j") == 0 && i+1 < argc){
+            pct = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-w") == 0 && i+1 < argc){
+            out = argv[++i];
+        }
+        else{
+            in = argv[i];
+        }
+    }
+
+    if(presses > 0){
+        srand(1);
+        generate(presses, pct);
+    }
+    else if(in){
+        FILE *fp = fopen(in, "rb");
+        if(fp == NULL){
+            perror(in);
+            return 1;
+        }
+        int c = fgetc(fp);
+        ungetc(c, fp);
+        if(((c == CAP_SYNC) ? load_dump(fp) : load_text(fp)) != 0){
+            fprintf(stderr, "%s: bad input\n", in);
+            return 1;
+        }
+        fclose(fp);
+    }
+    else{
+        fprintf(stderr, "usage: replay [-n passes] [-j pct] [-w out.txt] "
+                "(file | -s presses)\n");
+        return 1;
+    }
+    if(out){
+        save_text(out);
+    }
+    if(nedges == 0){
+        fprintf(stderr, "no edges\n");
+        return 1;
+    }
+
+    //Correctness
+    replay(1, NULL);
+    printf("edges %zu, frames %zu, events %zu\n", nedges, nframes, ngot/2);
+
+    int fail = 0;
+    if(nexpect){
+        size_t i = 0;
+        while((i < ngot) && (i < nexpect) && (got[i] == expect[i])
+                && (got[i+1] == expect[i+1])){
+            i += 2;
+        }
+        if((i == ngot) && (i == nexpect)){
+            printf("correct: %zu/%zu events\n", i/2, nexpect/2);
+        }
+        else{
+            fail = 1;
+            printf("MISMATCH at event %zu: got %s %d, expected %s %d\n", i/2,
+                    (i < ngot) ? names[got[i]] : "end",
+                    (i < ngot) ? got[i+1] : -1,
+                    (i < nexpect) ? names[expect[i]] : "end",
+                    (i < nexpect) ? expect[i+1] : -1);
+        }
+    }
+    else{
+        for(size_t i=0; i<ngot; i+=2){
+            printf("%s %u\n", names[got[i]], got[i+1]);
+        }
+    }
+
+    //Throughput
+    uint64_t t0 = now_ns();
+    for(int p=0; p<passes; p++){
+        replay(0, NULL);
+    }
+    double sec = (now_ns()-t0)/1e9;
+    if(sec > 0){
+        printf("throughput: %.0f frames/s, %.0f edges/s (%d passes)\n",
+                nframes*(double)passes/sec, nedges*(double)passes/sec, passes);
+    }
+
+    //Per edge cost, best of a few passes for each edge
+    uint64_t *cost = malloc(nedges*sizeof(*cost));
+    uint64_t total = 0;
+    uint64_t worst = 0;
+    for(size_t i=0; i<nedges; i++){
+        cost[i] = UINT64_MAX;
+    }
+    for(int p=0; p<COST_PASSES; p++){
+        replay(0, cost);
+    }
+    for(size_t i=0; i<nedges; i++){
+        total += cost[i];
+        if(cost[i] > worst){
+            worst = cost[i];
+        }
+    }
+    printf("ir_edge: mean %.1f %s, worst %lu %s\n",
+            (double)total/nedges, COST_UNIT, (unsigned long)worst, COST_UNIT);
+    free(cost);
+
+    return fail;
+}
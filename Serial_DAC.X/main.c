@@ -26,20 +26,51 @@
 //Configuration
 #pragma config WDTE = OFF   //Disable watch dog timer
 #pragma config LVP = ON      //Enable low voltage programming mode
-#define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by 
-                            //same frequency.
+#define _XTAL_FREQ 48000000 //Runs at 48MHz, OSCFRQ_48MHZ below
+#define OSCFRQ_48MHZ 0x07
+
+//Sample step of the wave, 50 steps per cycle
+#define WAVE_STEP_US 10     //Delay unit
+#define WAVE_STEP_MIN 20    //200us, 100Hz
+#define WAVE_STEP_MAX 200   //2ms, 10Hz
+
+//Background ADC scan, ADPCH of each input and its filter shift
+#define ADC_CHANNELS 2
+#define ADC_SCAN {0, 1}     //RA0 frequency, RA1 amplitude
+#define ADC_SMOOTH {1, 2}
+#define ADC_FREQ 0  //Scan index of the frequency control
+#define ADC_AMP 1   //Scan index of the amplitude control
+#define ADC_AVG 4   //Conversions averaged per trigger
+#define ADC_AVG_SHIFT 2 //log2 of ADC_AVG
+#define ADC_ACQ 20  //Acquisition time in ADC clocks
+#define ADC_PR 255  //Timer4 period, 31.25kHz/256 = 122Hz
+#define ADC_TRIGGER 0x06    //ADACT Timer4 postscaled
+#define AMP_MIN 51  //1V of the 5V full scale in 1/255
 
 //Declare methods
 void adc_init();    //Initialize PortA
 unsigned long adcNum0();    //Get ADC voltage
+void adc_start();   //Start the background scan
+unsigned long adcResult(unsigned char i);   //Get newest result of scan input i
 void spi_init();    //SPI initialization
 void spi_write(unsigned char data);     //SPI write
 
 //Global Variable
 unsigned long value0 = 0;   //Where to store the ADC result in (Voltage)
 unsigned long F = 0;  //Frequency
+unsigned int step = WAVE_STEP_MAX;  //Sample step in WAVE_STEP_US
 float temp = 0.0;   //Temporary Variable
 int volt = 5;   //Voltage reference
+unsigned char amp = 255;    //Output amplitude in 1/255 of full scale
+
+//Background scan
+const unsigned char adc_scan[ADC_CHANNELS] = ADC_SCAN;  //ADPCH of each input
+const unsigned char adc_smooth[ADC_CHANNELS] = ADC_SMOOTH;  //Filter shifts
+uint16_t adc_acc[ADC_CHANNELS];     //Filter state, result << shift
+volatile uint16_t adc_buf[ADC_CHANNELS][2];     //Results, double buffered
+volatile unsigned char adc_front[ADC_CHANNELS];     //Slot of the newest result
+volatile unsigned char adc_index = 0;   //Input being converted
+volatile unsigned char adc_seq = 0;     //Complete scans, wraps
 
 //Sine Wave
 char sin[50] = {
@@ -75,11 +106,12 @@ char sawtooth[50] = {
 };
 
 /*
- * The function will initialize the PORTA pin 0 to be input.
+ * The function will initialize the PORTA pin 0 and pin 1 to be input.
  * PORTB pin 0 as input. 
  */
 void adc_init(){
-    TRISAbits.TRISA0 = 1;  //Configure PORTA pin 0 as input
+    TRISAbits.TRISA0 = 1;  //Configure PORTA pin 0 as input (frequency)
+    TRISAbits.TRISA1 = 1;  //Configure PORTA pin 1 as input (amplitude)
    
     //Configure PORTB as input
     TRISBbits.TRISB0 = 1;
@@ -110,6 +142,83 @@ unsigned long adcNum0() {
     return (ADRES >> 6);
 }
 
+/*
+ * Start the background scan of the ADC_SCAN inputs. Timer4 runs from MFINTOSC
+ * so the scan rate does not depend on OSCFRQ. Each trigger runs a burst average
+ * of one input, the ADC threshold interrupt filters and publishes it and moves
+ * the channel select to the next input. Waits for the first full scan.
+ */
+void adc_start(){
+    //Timer4 paces the conversions
+    T4CLKCONbits.CS = 0b0101;   //MFINTOSC 31.25kHz
+    T4HLT = 0x00;   //Free running
+    T4CONbits.CKPS = 0;     //1:1
+    T4CONbits.OUTPS = 0;    //1:1
+    T4PR = ADC_PR;
+    T4CONbits.ON = 1;
+    
+    //ADC setup
+    ADCON0 = 0x00;
+    adc_index = 0;
+    ADPCH = adc_scan[0];    //First input
+    ADACQ = ADC_ACQ;    //Acquisition time, also settles the channel change
+    ADRPT = ADC_AVG;    //Conversions per trigger
+    ADCON2 = 0x00;
+    ADCON2bits.ADCRS = ADC_AVG_SHIFT;   //Divide the sum by ADC_AVG
+    ADCON2bits.ADMD = 0b011;    //Burst average mode
+    ADCON3bits.ADTMD = 0b111;   //Interrupt after every burst
+    ADACT = ADC_TRIGGER;
+    ADCON0bits.ADON = 1;    //Enable ADC
+    
+    //Interrupt enable
+    PIR1bits.ADTIF = 0;
+    PIE1bits.ADTIE = 1;
+    PEIE = 1;
+    GIE = 1;
+    
+    while(adc_seq == 0){};  //First scan
+}
+
+/*
+ * The burst result goes through the input's low pass filter,
+ * out = out + (in - out)/2^shift, into the slot the main loop is not reading,
+ * which then becomes the front slot. The first scan loads the filters directly.
+ */
+void __interrupt() ISR(){
+    if(PIR1bits.ADTIF){
+        PIR1bits.ADTIF = 0;
+        unsigned char i = adc_index;
+        unsigned char k = adc_smooth[i];
+        uint16_t in = ADFLTR;
+        
+        if(adc_seq == 0){
+            adc_acc[i] = in << k;
+        }
+        else{
+            adc_acc[i] = adc_acc[i] - (adc_acc[i] >> k) + in;
+        }
+        
+        unsigned char back = adc_front[i]^1;
+        adc_buf[i][back] = adc_acc[i] >> k;
+        adc_front[i] = back;
+        
+        //Next input
+        if(++i >= ADC_CHANNELS){
+            i = 0;
+            adc_seq++;
+        }
+        adc_index = i;
+        ADPCH = adc_scan[i];
+    }
+}
+
+/*
+ * Newest filtered result of scan input i, never waits.
+ */
+unsigned long adcResult(unsigned char i){
+    return adc_buf[i][adc_front[i]];
+}
+
 //Bit-banging DAC write
 //Used for testing
 //Reference: http://www.add.ece.ufl.edu/4924/
@@ -177,6 +286,7 @@ void spi_write(unsigned char data){
     LATCbits.LATC0 = 0;     //Enable output
     
     uint16_t full = 0xF000;     //Command for DAC
+    data = ((uint16_t)data*amp) >> 8;   //Scale to the amplitude
     full = full | (data << 4);  //Shift to DAC place
     
     uint8_t bound = (full >> 8);
@@ -199,20 +309,18 @@ void spi_write(unsigned char data){
  * 
  */
 void main() {         
-    OSCFRQ = 0x07;  //48 MHz
+    OSCFRQ = OSCFRQ_48MHZ;  //Must match _XTAL_FREQ
     
     adc_init();     //Initialized ADC ports
     spi_init();    //Initialized spi1
+    adc_start();    //Start background scan
     
     //Infinite loop to generate the function. 
     while(1){
-        //Load adc values
-        if(value0 == 0){    //Average out value
-            value0 = adcNum0();
-        }
-        else{
-            value0 = ((value0+adcNum0())/2)+2;   //Frequency ADC
-        }
+        //Load adc values, filtered in the background
+        value0 = adcResult(ADC_FREQ);   //Frequency ADC
+        step = WAVE_STEP_MIN + (((WAVE_STEP_MAX-WAVE_STEP_MIN)*value0) >> 10);
+        amp = AMP_MIN + (((255-AMP_MIN)*adcResult(ADC_AMP)) >> 10);  //1V to 5V
         
         //Port B pin 0 and pin 1
         //(0,0) sin
@@ -225,8 +333,8 @@ void main() {
             for (int x = 0; x < 50; x++){
                 unsigned char volatile outv = (int)(sin[x]);     //Adjust to voltage
                 spi_write(outv);
-                for(int i=0; i<(unsigned int)((value0)/8); i++){
-                    __delay_ms(1);
+                for(unsigned int i=0; i<step; i++){
+                    __delay_us(WAVE_STEP_US);
                 }
             }
         }
@@ -235,8 +343,8 @@ void main() {
             for (int x = 0; x < 50; x++){
                 unsigned char volatile outv = (int)(square[x]);     //Adjust to voltage
                 spi_write(outv);
-                 for(int i=0; i<(unsigned int)((value0)/8); i++){
-                    __delay_ms(1);
+                 for(unsigned int i=0; i<step; i++){
+                    __delay_us(WAVE_STEP_US);
                 }
             }
         }
@@ -245,8 +353,8 @@ void main() {
             for (int x = 0; x < 50; x++){
                 unsigned char volatile outv = (int)(triangle[x]);     //Adjust to voltage
                 spi_write(outv);
-                 for(int i=0; i<(unsigned int)((value0)/8); i++){
-                    __delay_ms(1);
+                 for(unsigned int i=0; i<step; i++){
+                    __delay_us(WAVE_STEP_US);
                 }
             }
         }
@@ -255,8 +363,8 @@ void main() {
            for (int x = 0; x < 50; x++){
                 unsigned char volatile outv = (int)(sawtooth[x]);     //Adjust to voltage
                 spi_write(outv);
-                 for(int i=0; i<(unsigned int)((value0)/8); i++){
-                    __delay_ms(1);
+                 for(unsigned int i=0; i<step; i++){
+                    __delay_us(WAVE_STEP_US);
                 }
             }
         }
@@ -7,9 +7,43 @@
 #include <xc.h>     //Contain the PIC C commands
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+#define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by 
+                            //same frequency.
+
+#define ADC_AVG 16  //Conversions averaged by adcAvg0()
+#define ADC_AVG_SHIFT 4 //log2 of ADC_AVG
+#define ADC_ACQ 20  //Acquisition time in ADC clocks
+#define ADC_PR 77   //Timer4 period, 1MHz/64/78 = 200Hz
+#define ADC_TRIGGER 0x06    //ADACT Timer4 postscaled
+
+//How adcRead0() gets a value, the one shot modes leave the scan stopped
+#define ADC_READ_BACKGROUND 0   //Newest background scan result
+#define ADC_READ_BUSY 1     //adcAvg0(), CPU waits on the burst
+#define ADC_READ_SLEEP 2    //adcSleep0(), CPU sleeps during the burst
+#define ADC_READ ADC_READ_BACKGROUND    //Low fuel LED needs the scan
+
+//Background scan, ADPCH of each input and its filter shift (0 = no filter)
+#define ADC_CHANNELS 1
+#define ADC_SCAN {0}    //RA0 fuel level
+#define ADC_SMOOTH {2}
+#define ADC_RA0 0   //Scan index of RA0
+
+//Low fuel warning thresholds on the burst average
+#define ADC_LOW_ON 101  //On below, 10% of full scale
+#define ADC_LOW_OFF 120 //Off above
 
 void adc_init();
 unsigned long adcNum0();    //Get ADC value
+unsigned long adcAvg0();    //Get averaged ADC value
+unsigned long adcSleep0();  //Get averaged ADC value in Sleep
+unsigned long adcRead0();   //Get ADC value, ADC_READ mode
+void adc_start();   //Start background conversions
+void adc_isr();     //Background conversion interrupt
+unsigned long adcResult(unsigned char i);   //Get newest result of scan input i
+unsigned long adcLatest0(); //Get newest background ADC value
+unsigned char adcLow();     //Fuel below the warning level
 
 #endif	/* ADC_H */
 
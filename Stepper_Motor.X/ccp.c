@@ -0,0 +1,148 @@
+/*
+ * CCP functions.
+ * Timer1 is extended to 32 bits by counting overflows so every rising edge on
+ * RC2 gets a timestamp. The ISR keeps the last CCP_WINDOW periods and publishes
+ * their median, reading it from the main loop never waits on the input.
+ */
+#include "ccp.h"
+#include "adc.h"
+
+//Global Variables
+volatile uint16_t ccp_high = 0;     //Timer1 overflows, upper 16 bits of time
+volatile uint32_t ccp_last = 0;     //Time of the last rising edge
+volatile uint32_t ccp_median = 0;   //Median of the period window
+volatile unsigned char ccp_edges = 0;   //Edges seen, stops at CCP_WINDOW+1
+uint32_t ccp_window[CCP_WINDOW];    //Last periods
+unsigned char ccp_next = 0;     //Window slot for the next period
+
+/*
+ *  Initialize ccp and timer1
+ */
+void ccp_init(){
+    //Timer setup
+    TMR1 = 0;   //Initialize to 0
+    T1CKPS0 = 1;
+    T1CKPS1 = 1;
+    T1CONbits.NOT_SYNC = 0;
+    T1CONbits.RD16 = 1;
+    TMR1CLKbits.CS=1;
+    TMR1IF=0;
+    TMR1ON = 1;
+    
+    //CCP setup
+    CCP1PPS=0x12;   //Setup input PPS
+    CCPR1=0x00;     //Clear
+    CCP1CONbits.MODE=0x05;  //Rising edge
+    CCP1CONbits.EN = 1;  //Enable ccp
+    CCP1IF=0;
+    
+    //Interrupt enable
+    TMR1IE = 1;     //Count overflows
+    CCP1IE = 1;
+    PEIE = 1;
+    GIE = 1;
+}
+
+/*
+ * Median of the filled part of the window, insertion sort of a copy.
+ */
+uint32_t ccp_filter(unsigned char n){
+    uint32_t sorted[CCP_WINDOW];
+    
+    for(unsigned char i=0; i<n; i++){
+        uint32_t p = ccp_window[i];
+        unsigned char j = i;
+        while((j > 0) && (sorted[j-1] > p)){
+            sorted[j] = sorted[j-1];
+            j--;
+        }
+        sorted[j] = p;
+    }
+    return sorted[n/2];
+}
+
+void __interrupt() ISR(){
+    if (CCP1IF){  //Rising edge, extend the capture to 32 bits
+        CCP1IF = 0;
+        uint16_t high = ccp_high;
+        uint16_t low = CCPR1;
+        
+        //Overflow pending but not counted yet, capture was after it
+        if(TMR1IF && (low < 0x8000)){
+            high++;
+        }
+        uint32_t now = ((uint32_t)high << 16) | low;
+        
+        if(ccp_edges > 0){  //Period since the last edge
+            ccp_window[ccp_next] = now - ccp_last;
+            if(++ccp_next == CCP_WINDOW){
+                ccp_next = 0;
+            }
+            if(ccp_edges <= CCP_WINDOW){
+                ccp_median = ccp_filter(ccp_edges);
+            }
+            else{
+                ccp_median = ccp_filter(CCP_WINDOW);
+            }
+        }
+        if(ccp_edges <= CCP_WINDOW){
+            ccp_edges++;
+        }
+        ccp_last = now;
+    }
+    if (TMR1IF){    //Upper 16 bits of time
+        TMR1IF = 0;
+        ccp_high++;
+    }
+}
+
+/*
+ * Filtered period in Timer1 ticks (8us). Once the input has been quiet for
+ * longer than the median the quiet time is the better estimate, so a slowing
+ * input reads lower straight away. Returns 0 when stopped.
+ */
+uint32_t ccp_period(){
+    uint16_t high;
+    uint16_t low;
+    uint32_t last;
+    uint32_t median;
+    unsigned char edges;
+    
+    GIE = 0;
+    low = TMR1;
+    high = ccp_high;
+    if(TMR1IF && (low < 0x8000)){   //Overflow not counted yet
+        high++;
+    }
+    last = ccp_last;
+    median = ccp_median;
+    edges = ccp_edges;
+    GIE = 1;
+    
+    if(edges < 2){  //No period yet
+        return 0;
+    }
+    uint32_t quiet = (((uint32_t)high << 16) | low) - last;
+    if(quiet >= CCP_STOP){
+        return 0;
+    }
+    if(quiet > median){
+        return quiet;
+    }
+    return median;
+}
+
+/*
+ * Read ccp value and convert to frequency in Hz, rounded down.
+ */
+unsigned int ccpNum0(){
+    uint32_t period = ccp_period();
+    
+    if(period == 0){
+        return 0;
+    }
+    if(period < 2){     //Above the range of the gauge
+        return 0xFFFF;
+    }
+    return CCP_TICK_HZ/period;
+}
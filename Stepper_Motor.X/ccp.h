@@ -0,0 +1,20 @@
+/* 
+ * Header for ccp functions.
+ */
+
+#ifndef CCP_H
+#define	CCP_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+
+#define CCP_WINDOW 5    //Periods in the median window
+#define CCP_STOP 500000UL   //No edge for 4s (8us ticks) reads as stopped
+#define CCP_TICK_HZ (_XTAL_FREQ/4/8)    //Timer1 ticks per second
+
+void ccp_init();
+uint32_t ccp_period();  //Filtered period in 8us ticks, 0 when stopped
+unsigned int ccpNum0();     //Frequency in Hz
+
+#endif	/* CCP_H */
+
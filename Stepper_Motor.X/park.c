@@ -0,0 +1,192 @@
+/*
+ * Gauge park functions.
+ * Keeps where both gauges stand, and their coil phases, in data EEPROM so a
+ * reset does not have to home them again. Each save goes to the next slot of
+ * a ring of records with a sequence number and a check byte, the newest
+ * record that checks out is the one read at boot. A state byte outside the
+ * check is written last with the record and cleared before the gauges next
+ * move, so a reset in the middle of a move, or of a save, reads as not
+ * parked. Saves wait for the gauges to settle and are spaced at least
+ * PARK_GAP apart, together with the ring this keeps each cell well inside its
+ * write endurance.
+ */
+#include "park.h"
+#include "step.h"
+
+//Global Variables
+unsigned char park_slot = PARK_SIZE/PARK_SLOT-1;   //Slot of the newest record
+uint16_t park_seq = 0;  //Sequence number of the newest record
+unsigned char park_state = PARK_MOVING;    //State byte of the newest record
+unsigned char park_ok = 0;  //The newest record holds the gauge positions
+int16_t park_pos[STEP_MOTORS] = {0, 0};     //Positions read at boot
+unsigned char park_coils = 0;   //Coil phases read at boot, right low nibble
+uint16_t park_still = 0;    //Last time a gauge was seen moving
+uint16_t park_saved = 0;    //Time of the last save
+
+/*
+ * Read a byte of data EEPROM.
+ */
+unsigned char park_read(uint16_t addr){
+    NVMCON1bits.REG = 0;    //Data EEPROM
+    NVMADRL = addr;
+    NVMADRH = addr >> 8;
+    NVMCON1bits.RD = 1;
+    return NVMDAT;
+}
+
+/*
+ * Write a byte of data EEPROM, skipped when it holds data already. Waits for
+ * the write, about 4ms.
+ */
+void park_write(uint16_t addr, unsigned char data){
+    if(park_read(addr) == data){
+        return;
+    }
+    NVMDAT = data;
+    NVMCON1bits.WREN = 1;
+    
+    //Unlock sequence, nothing may come between
+    GIE = 0;
+    NVMCON2 = 0x55;
+    NVMCON2 = 0xAA;
+    NVMCON1bits.WR = 1;
+    GIE = 1;
+    
+    while(NVMCON1bits.WR){};
+    NVMCON1bits.WREN = 0;
+}
+
+/*
+ * Timer0 count, PARK_TICK_HZ. TMR0H is latched by reading TMR0L.
+ */
+uint16_t park_time(){
+    uint16_t low = TMR0L;
+    return ((uint16_t)TMR0H << 8) | low;
+}
+
+/*
+ * Check byte of the record in slot.
+ */
+unsigned char park_check(unsigned char slot){
+    uint16_t addr = (uint16_t)slot*PARK_SLOT;
+    unsigned char check = PARK_KEY;
+    
+    for(unsigned char i=0; i<PARK_CHECK; i++){
+        check ^= park_read(addr+i);
+    }
+    return check;
+}
+
+/*
+ * Starts the throttle timer and finds the newest record. The drive modes
+ * must be set already, a record saved in other modes is not used.
+ */
+void park_init(){
+    //Timer0 free running, 16-bit
+    T0CON0 = 0x00;
+    T0CON0bits.T016BIT = 1;
+    T0CON1bits.T0CS = 0b100;    //LFINTOSC
+    T0CON1bits.T0ASYNC = 1;
+    T0CON1bits.T0CKPS = 0b1010; //1:1024
+    TMR0H = 0;
+    TMR0L = 0;
+    T0CON0bits.T0EN = 1;
+    park_saved = park_time()-PARK_GAP;  //First save needs no gap
+    
+    //Newest record that checks out
+    unsigned char found = 0;
+    for(unsigned char slot=0; slot<PARK_SIZE/PARK_SLOT; slot++){
+        uint16_t addr = (uint16_t)slot*PARK_SLOT;
+        if(park_check(slot) != park_read(addr+PARK_CHECK)){
+            continue;
+        }
+        uint16_t seq = park_read(addr) | ((uint16_t)park_read(addr+1) << 8);
+        if(!found || ((int16_t)(seq-park_seq) > 0)){
+            found = 1;
+            park_slot = slot;
+            park_seq = seq;
+        }
+    }
+    if(!found){
+        return;
+    }
+    
+    uint16_t addr = (uint16_t)park_slot*PARK_SLOT;
+    park_state = park_read(addr+PARK_STATE);
+    park_pos[STEP_RIGHT] = park_read(addr+2) | (park_read(addr+3) << 8);
+    park_pos[STEP_LEFT] = park_read(addr+4) | (park_read(addr+5) << 8);
+    park_coils = park_read(addr+7);
+    park_ok = (park_state == PARK_PARKED) && (park_read(addr+6) == 
+            (step_micro(STEP_RIGHT) | (step_micro(STEP_LEFT) << 4)));
+}
+
+/*
+ * 1 when the gauges were parked at the positions saved, homing can be
+ * skipped.
+ */
+unsigned char park_valid(){
+    return park_ok;
+}
+
+/*
+ * Saved position of gauge m in steps of its drive mode, when park_valid().
+ */
+int16_t park_position(unsigned char m){
+    return park_pos[m];
+}
+
+/*
+ * Saved coil phase of gauge m, when park_valid().
+ */
+unsigned char park_phase(unsigned char m){
+    return (m == STEP_RIGHT) ? (park_coils & 0x0F) : (park_coils >> 4);
+}
+
+/*
+ * Call before moving a gauge or changing its position. Clears the state of a
+ * parked record, once.
+ */
+void park_moving(){
+    if(park_state == PARK_PARKED){
+        park_write((uint16_t)park_slot*PARK_SLOT+PARK_STATE, PARK_MOVING);
+        park_state = PARK_MOVING;
+    }
+}
+
+/*
+ * Call from the main loop. Saves both positions to the next slot once the
+ * gauges have settled, if they moved since the last save and it is at least
+ * PARK_GAP ago.
+ */
+void park_poll(){
+    uint16_t now = park_time();
+    
+    if(step_busy(STEP_RIGHT) || step_busy(STEP_LEFT)){
+        park_still = now;
+        return;
+    }
+    if((park_state == PARK_PARKED) || ((now-park_still) < PARK_SETTLE) ||
+            ((now-park_saved) < PARK_GAP)){
+        return;
+    }
+    
+    park_slot = (park_slot+1) & (PARK_SIZE/PARK_SLOT-1);
+    park_seq++;
+    
+    uint16_t addr = (uint16_t)park_slot*PARK_SLOT;
+    int16_t right = step_position(STEP_RIGHT);
+    int16_t left = step_position(STEP_LEFT);
+    park_write(addr+PARK_STATE, PARK_MOVING);   //Not parked until complete
+    park_write(addr, park_seq);
+    park_write(addr+1, park_seq >> 8);
+    park_write(addr+2, right);
+    park_write(addr+3, right >> 8);
+    park_write(addr+4, left);
+    park_write(addr+5, left >> 8);
+    park_write(addr+6, step_micro(STEP_RIGHT) | (step_micro(STEP_LEFT) << 4));
+    park_write(addr+7, step_coils(STEP_RIGHT) | (step_coils(STEP_LEFT) << 4));
+    park_write(addr+PARK_CHECK, park_check(park_slot));
+    park_write(addr+PARK_STATE, PARK_PARKED);
+    park_state = PARK_PARKED;
+    park_saved = now;
+}
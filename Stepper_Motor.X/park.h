@@ -0,0 +1,31 @@
+/*
+ * Header for gauge park functions.
+ */
+#ifndef PARK_H
+#define	PARK_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+
+//Data EEPROM ring of position records
+#define PARK_SIZE 1024  //Bytes of data EEPROM
+#define PARK_SLOT 16    //Bytes per record, PARK_SIZE/PARK_SLOT slots
+#define PARK_CHECK 8    //Offset of the check byte, XOR of the ones before
+#define PARK_STATE 9    //Offset of the state byte, not in the check
+#define PARK_PARKED 0xA5    //State, written with the record, gauges stopped
+#define PARK_MOVING 0x00    //State, the gauges have moved since
+#define PARK_KEY 0x5A   //Check seed, a blank EEPROM never passes
+
+//Write throttle, Timer0 from LFINTOSC 1:1024, ~30 ticks per second
+#define PARK_TICK_HZ 30
+#define PARK_SETTLE (1*PARK_TICK_HZ)    //Stopped this long before a save
+#define PARK_GAP (30*PARK_TICK_HZ)      //Least time between saves
+
+void park_init();
+unsigned char park_valid();
+int16_t park_position(unsigned char m);
+unsigned char park_phase(unsigned char m);
+void park_moving();
+void park_poll();
+
+#endif	/* PARK_H */
@@ -22,218 +22,164 @@
 
 //Includes files
 #include "adc.h"
+#include "ccp.h"
+#include "step.h"
+#include "park.h"
 #include <math.h>
 #include <stdint.h>
 
 //Configuration
 #pragma config WDTE = OFF   //Disable watch dog timer
 #pragma config LVP = ON      //Enable low voltage programming mode
-#define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by 
-                            //same frequency.
+
+//Gauges
+#define GAUGE_ZERO 196  //Full steps from the brake line to the dial zero
+#define GAUGE_BRAKE (STEP_REV-GAUGE_ZERO)   //Brake line, full steps from zero
+#define GAUGE_BAND 2    //Full steps of change ignored, ADC noise
+#define GAUGE_SPEED_MIN 5   //Hz, slower reads as stopped
+#define GAUGE_DRIFT 16  //Full steps of drift corrected, more is a false edge
+
+//Homing phases
+#define HOME_SEEK 0     //Fast, latch the beam edge
+#define HOME_BACK 1     //Back off to before the edge
+#define HOME_CREEP 2    //Slow, stop on the edge
+#define HOME_ZERO 3     //Out to the dial zero
+#define HOME_DONE 4
+#define HOME_MARGIN 8   //Full steps backed off before the edge
+
+//Calibration, dial position in full steps from zero at evenly spaced inputs.
+//The scale of the old step counts, 1.6 steps per ADC code and 16.4 per Hz, 
+//up to a full scale of 1638 steps (288 degrees). Held there above, short of
+//the brake line at one turn less GAUGE_ZERO, retune per dial face.
+#define CAL_POINTS 9
+#define FUEL_SPAN 128   //ADC codes between points
+#define SPEED_SPAN 25   //Half Hz between points, full scale at 100Hz
+const int16_t fuel_cal[CAL_POINTS] = {
+    0, 205, 410, 614, 819, 1024, 1229, 1434, 1638
+};
+const int16_t speed_cal[CAL_POINTS] = {
+    0, 205, 410, 614, 819, 1024, 1229, 1434, 1638
+};
 
 //Global Variable
 unsigned long value0 = 0;   //Where to store the ADC result
-unsigned long currfuel = 0;   //Current fuel level
-unsigned long currfreq = 0;   //Current frequency
-int step = 1;   //Current step
-int stepf = 1;   //Current step
-int freq = 0;     //Current frequency
-int test = 0;   //Tester variable
-int temp = 0;   //Temporary variable
-int check = 0;
+unsigned int freq = 0;     //Current frequency
+unsigned char home[STEP_MOTORS];    //Homing phase of each gauge
 
 /*
- * Right Stepper Motor 
- * A3-OPTO2    
- * B3-M2 INT1    
- * B2-M2 INT2    
- * B1-M2 INT3   
- * B0-M2 INT4   
+ * Dial position of input in from a calibration table with span inputs between
+ * points, linear in between and held at the last point.
  */
-void steptakeR(int dir){
-    if(dir == 1){   //cw
-        switch((char)step){
-            case 1:
-                PORTB = 0b1100;
-                __delay_ms(2);
-                step++;
-                break;
-            case 2:
-                PORTB = 0b1001;
-                __delay_ms(2);
-                step++;
-                break;
-            case 3:
-                PORTB = 0b0011;
-                __delay_ms(2);
-                step++;
-                break;
-            case 4:
-                PORTB = 0b0110;
-                __delay_ms(2);
-                step++;
-                break;
-            default:
-                step = 1;   //Reset step
-        }
-    }
-    else if(dir == 2){   //ccw
-        switch((char)step){
-            case 1:
-                PORTB = 0b1100;
-                __delay_ms(2);
-                step++;
-                break;
-            case 2:
-                PORTB = 0b0110;
-                __delay_ms(2);
-                step++;
-                break;
-            case 3:
-                PORTB = 0b0011;
-                __delay_ms(2);
-                step++;
-                break;
-            case 4:
-                PORTB = 0b1001;
-                __delay_ms(2);
-                step++;
-                break;
-            default:
-                step = 1;   //Reset step
-        }
+int16_t gauge_cal(const int16_t *cal, uint16_t span, uint16_t in){
+    uint16_t i = in/span;
+    
+    if(i >= CAL_POINTS-1){
+        return cal[CAL_POINTS-1];
     }
+    return cal[i]+((int32_t)(cal[i+1]-cal[i])*(in-i*span))/span;
 }
 
 /*
- * Left Stepper Motor 
- * A4-OPTO1
- * D3-M1 INT1
- * D2-M1 INT2
- * D1-M1 INT3
- * D0-M1 INT4
+ * The last clockwise move of gauge m crossed into its opto beam. The edge is
+ * GAUGE_ZERO full steps before the dial zero, so where it was latched shows
+ * how far the position has drifted, put it right.
  */
-void steptakeL(int dir){
-    if(dir == 1){   //cw
-        switch((char)stepf){
-            case 1:
-                PORTD = 0b1100;
-                __delay_ms(2);
-                stepf++;
-                break;
-            case 2:
-                PORTD = 0b1001;
-                __delay_ms(2);
-                stepf++;
-                break;
-            case 3:
-                PORTD = 0b0011;
-                __delay_ms(2);
-                stepf++;
-                break;
-            case 4:
-                PORTD = 0b0110;
-                __delay_ms(2);
-                stepf++;
-                break;
-            default:
-                stepf = 1;   //Reset step
-        }
+void gauge_drift(unsigned char m){
+    if(!step_tripped(m)){
+        return;
     }
-    else if(dir == 2){   //ccw
-        switch((char)stepf){
-            case 1:
-                PORTD = 0b1100;
-                __delay_ms(2);
-                stepf++;
-                break;
-            case 2:
-                PORTD = 0b0110;
-                __delay_ms(2);
-                stepf++;
-                break;
-            case 3:
-                PORTD = 0b0011;
-                __delay_ms(2);
-                stepf++;
-                break;
-            case 4:
-                PORTD = 0b1001;
-                __delay_ms(2);
-                stepf++;
-                break;
-            default:
-                stepf = 1;   //Reset step
-        }
+    int16_t err = step_wrap(m, -GAUGE_ZERO*step_micro(m)-step_latched(m));
+    
+    if((err != 0) && (abs(err) <= GAUGE_DRIFT*step_micro(m))){
+        park_moving();
+        step_adjust(m, err);
     }
 }
 
 /*
- *  Initialize ccp and timer1
+ * Move gauge m the shortest way to a dial position in full steps, unless it
+ * is within GAUGE_BAND already, but never across the brake line. The dial
+ * ends short of it so the other way round stays on the face. Only starts once
+ * the last move has finished, clockwise moves latch the opto edge for
+ * gauge_drift().
+ * Right Stepper Motor: A3-OPTO2, B3..B0-M2 INT1..INT4
+ * Left Stepper Motor: A4-OPTO1, D3..D0-M1 INT1..INT4
  */
-void ccp_init(){
-    //Timer setup
-    TMR1 = 0;   //Initialize to 0
-    T1CKPS0 = 1;
-    T1CKPS1 = 1;
-    T1CONbits.NOT_SYNC = 0;
-    T1CONbits.RD16 = 1;
-    TMR1CLKbits.CS=1;
-    TMR1IF=0;
-    TMR1ON = 1;
-    
-    //CCP setup
-    CCP1PPS=0x12;   //Setup input PPS
-    CCPR1=0x00;     //Clear
-    CCP1CONbits.MODE=0x05;  //Rising edge
-    CCP1CONbits.EN = 1;  //Enable ccp
+void gauge_to(unsigned char m, int16_t target){
+    if(step_busy(m)){
+        return;
+    }
+    gauge_drift(m);
+    int16_t rev = STEP_REV*step_micro(m);
+    int16_t d = step_path(m, target*step_micro(m));
+    int16_t brake = step_path(m, GAUGE_BRAKE*step_micro(m));
     
+    if((d > 0) && (brake > 0) && (d >= brake)){     //Would cross it clockwise
+        d -= rev;
+    }
+    else if((d < 0) && (brake < 0) && (d <= brake)){    //Counterclockwise
+        d += rev;
+    }
     
-    //Interrupt enable
-    CCP1IE = 1;
-    PEIE = 1;
-    GIE = 1;
+    if(d > GAUGE_BAND*step_micro(m)){
+        park_moving();
+        step_move(m, d, STEP_CW, STEP_MARK);
+    }
+    else if(d < -GAUGE_BAND*step_micro(m)){
+        park_moving();
+        step_move(m, -d, STEP_CCW, 0);
+    }
 }
 
-unsigned long f=0;
-unsigned long f2=0;
-unsigned long f3=0;
-/*void __interrupt() ISR(){
-  if (CCP1IF){  //If Capture Event Occurs, load f
-    f = CCPR1;
+/*
+ * Next homing phase of gauge m once its last move has finished. The seek runs
+ * at full speed and only latches where the beam broke, the gauge is then
+ * backed off past its overshoot and creeps onto the edge again to stop on it.
+ */
+void gauge_home(unsigned char m){
+    unsigned char micro = step_micro(m);
     
-    //Reset
-    CCP1IF = 0;
-    //TMR1 = 0;
-  }
-}*/
-
+    if(step_busy(m)){
+        return;
+    }
+    park_moving();
+    switch(home[m]){
+        case HOME_SEEK:
+            step_limit(m, STEP_TOP);
+            step_move(m, STEP_SEEK*micro, STEP_CW, STEP_LATCH);
+            home[m] = HOME_BACK;
+            break;
+        case HOME_BACK:
+            if(!step_tripped(m)){   //No opto in two turns, zero where it is
+                home[m] = HOME_DONE;
+                break;
+            }
+            step_move(m, HOME_MARGIN*micro-step_path(m, step_latched(m)), 
+                    STEP_CCW, 0);
+            home[m] = HOME_CREEP;
+            break;
+        case HOME_CREEP:
+            step_limit(m, STEP_CREEP);
+            step_move(m, 2*HOME_MARGIN*micro, STEP_CW, STEP_HALT);
+            home[m] = HOME_ZERO;
+            break;
+        case HOME_ZERO:
+            step_limit(m, STEP_TOP);
+            step_move(m, GAUGE_ZERO*micro, STEP_CW, 0);
+            home[m] = HOME_DONE;
+            break;
+    }
+}
 
 /*
- * Read ccp value and convert to frequency.
+ * Low priority interrupt, background ADC results and the step timer. The low
+ * fuel LED follows the threshold comparator so it does not wait for a gauge
+ * move to finish.
  */
-float ccpNum0(){
-    for(int q=0; q<5; q++){
-        //wait till pulse signal
-        while(!PIR6bits.CCP1IF);
-        PIR6bits.CCP1IF=0;  //Reset
-        f=CCPR1;  //Puts the timer value
-        
-        if(CCPR1>60000){
-            return f3=0;
-        }
-        
-        while(!PIR6bits.CCP1IF);    //Wait till the pulse is done
-        PIR6bits.CCP1IF = 0;
-        f2=CCPR1;  //Puts the timer value
-
-        if (f < f2){           //Get frequency
-          unsigned long period = f2-f;
-          f3=((((float)_XTAL_FREQ/4)/((float)period*8))+f3)/2;
-        }
-        TMR1 = 0;
-    }
-    return f3;
+void __interrupt(low_priority) ISR_low(){
+    adc_isr();
+    LATAbits.LATA2 = adcLow();
+    step_isr();
 }
 
 /*
@@ -242,6 +188,10 @@ float ccpNum0(){
 void main(){       
     adc_init();     //Initialize ADC ports
     ccp_init();     //Initialize ccp 
+    adc_start();    //Start background ADC
+    step_init();    //Step timer
+    step_mode(STEP_RIGHT, STEP_HALF);
+    step_mode(STEP_LEFT, STEP_HALF);
     
     TRISAbits.TRISA2 = 0;   //Configure PORTC pin 2 as output   (LED)
     PORTAbits.RA2 = 0;  //Clear and enable
@@ -257,160 +207,47 @@ void main(){
     TRISCbits.TRISC2 = 1;   //Configure PORTC pin 2 as input    (Frequency)
     ANSELC = 0x0;   //Clear and Enable
     
-    //Find absolute position
-    while(PORTAbits.RA3!=1){
-        steptakeR(1);
-    }
-    //Move to zero
-    for(int t=0; t<245; t++){   //Right
-        steptakeR(1);
+    park_init();    //Saved positions, after the drive modes
+    
+    //Parked at a saved position, otherwise find absolute position and move 
+    //to zero, both gauges at once
+    home[STEP_RIGHT] = HOME_SEEK;
+    home[STEP_LEFT] = HOME_SEEK;
+    if(park_valid()){
+        step_place(STEP_RIGHT, park_position(STEP_RIGHT), 
+                park_phase(STEP_RIGHT));
+        step_place(STEP_LEFT, park_position(STEP_LEFT), 
+                park_phase(STEP_LEFT));
+        home[STEP_RIGHT] = HOME_DONE;
+        home[STEP_LEFT] = HOME_DONE;
     }
-     //Find absolute position
-    while(PORTAbits.RA4!=1){
-        steptakeL(1);
+    while((home[STEP_RIGHT] != HOME_DONE) || (home[STEP_LEFT] != HOME_DONE) ||
+            step_busy(STEP_RIGHT) || step_busy(STEP_LEFT)){
+        gauge_home(STEP_RIGHT);
+        gauge_home(STEP_LEFT);
     }
-    //Move to zero
-    for(int t=0; t<245; t++){   //Right
-        steptakeL(1);
+    if(!park_valid()){
+        step_zero(STEP_RIGHT);
+        step_zero(STEP_LEFT);
     }
 
-    //Infinite loop. 
+    //Infinite loop, each gauge heads for its newest reading once it has
+    //finished the last move, so both track in parallel. 
     while(1){           
-        //Reset
-        int n=0;    //Extra steps
-        
         //Right Gauge- Fuel Level
         //Load adc values
-        for(int w=0; w<10;w++){
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
-            }
-            else{
-                value0 = ((value0+adcNum0())/2);   //ADC average
-           }
-        }
-        //------------------------------------------------------------------------
-        //Determine shortest path
-        if(abs(currfuel-value0)>1){
-            if((value0<currfuel)&&(temp==0)){
-                __delay_ms(100);
-                temp=1;
-            }
-            else{
-                int dist =((value0/3)-(currfuel/3)+360)%360;
-                if(dist<= 180){
-                    //Extra steps for 5V 
-                    if(value0>1000){
-                        for(n=0; n<77; n++){
-                            steptakeR(1);
-                            test=1;
-                        }
-                    }
-                    //Go cw
-                    for(int t=0; t<((int)value0-currfuel)*2+800/value0; t++){
-                        steptakeR(1);
-                        if(PORTAbits.RA3==1){   //Cross brake line
-                            //Move to 0
-                            for(int t=0; t<245; t++){ 
-                                steptakeR(1);
-                            }
-                            //Continue to value
-                            for(int t=0; t<abs((int)value0)*2; t++){
-                                steptakeR(1);
-                                currfuel = value0/2; 
-                            }
-                            break;
-                        }
-                    }
-                    currfuel = value0;    //New position is now current position
-                }
-                else if (dist>180){                 
-                    //Remove extra steps for 5V 
-                    if (test==1){
-                        for(n=0; n<77; n++){
-                            steptakeR(2);
-                            test=0;
-                        }
-                    }
-                    //Go ccw
-                    for(int t=0; t<abs(currfuel-(int)value0)*2-400/value0; t++){
-                        steptakeR(2);
-                        //Adjust for zero
-                        if((value0==0)&&(currfuel>1000)){
-                            currfuel=currfuel+50;
-                        }
-                        if(PORTAbits.RA3==1){   //Cross brake line
-                            //Move to 10
-                            for(int t=0; t<240; t++){ 
-                                steptakeR(2);
-                            }
-                            //Continue to value
-                            for(int t=0; t<abs(2048/2-(int)value0)*2; t++){
-                                steptakeR(2);
-                            }
-                            currfuel = value0; 
-                            break;
-                        }
-                    }
-                    currfuel = value0;    //New position is now current position 
-                }
-                temp=0;
-            }
-        }
-            
-        //Turn on LED when fuel is below 10%
-        if(value0 <= 100){
-             LATAbits.LATA2 =1;
-        }
-        else{
-            LATAbits.LATA2 =0;
-        }
+        value0 = adcRead0();   //Background unless ADC_READ says otherwise
+        gauge_to(STEP_RIGHT, gauge_cal(fuel_cal, FUEL_SPAN, value0));
+
         //------------------------------------------------------------------------
-        freq=ccpNum0()+1;
-        if(abs(currfreq-freq)>=1){
-            if(freq<5){
-                freq=0;
-            }
-            int dist2 =((int)(freq/0.2778)-(int)(currfreq/0.2778)+360)%360;
-            if(dist2<= 180){
-                //Go cw
-                for(int t=0; t<(freq-currfreq)*20.48+1000/(freq*9)+freq/3; t++){
-                    steptakeL(1);
-                    if(PORTAbits.RA4==1){   //Cross brake line
-                        //Move to 0
-                        for(int t=0; t<245; t++){ 
-                            steptakeL(1);
-                        }
-                        //Continue to value
-                        for(int t=0; t<abs((int)freq)*20; t++){
-                            steptakeL(1);
-                        }
-                        currfreq = freq;
-                        break;
-                    }
-                }
-                currfreq = freq;
-            }
-            else if (dist2>180){  
-                //Go ccw       
-                for(int t=0; t<abs(currfreq-(int)freq)*20.48-500/(freq*10); t++){
-                    steptakeL(2);
-                    if(PORTAbits.RA4==1){   //Cross brake line
-                        //Move to 10
-                        for(int t=0; t<245; t++){ 
-                            steptakeL(2);
-                        }
-                        //Continue to value
-                        for(int t=0; t<abs(2000/2-(int)freq*10)*2; t++){
-                            steptakeL(2);
-                        }
-                        currfreq = freq;
-                        break;
-                    }
-                }
-                currfreq = freq;    //New position is now current position */      
-            }
+        //Left Gauge- Speed
+        freq = ccpNum0();
+        if(freq < GAUGE_SPEED_MIN){
+            freq = 0;
         }
+        gauge_to(STEP_LEFT, gauge_cal(speed_cal, SPEED_SPAN, freq*2));
+        
+        park_poll();    //Save the positions once both have settled
     }
     return;
-}
\ No newline at end of file
+}
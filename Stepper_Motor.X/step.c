@@ -0,0 +1,359 @@
+/*
+ * Stepper motor functions.
+ * Both motors run from one Timer3 interrupt. Each moving motor counts down the
+ * time to its next step, the timer is loaded with the nearest one and every
+ * motor that is due steps in the same interrupt, both coil patterns written
+ * together. Moves run in the background. Periods come from step_ramp, a
+ * constant acceleration of 20000 steps/s^2 from 250 to 1000 steps/s. A move
+ * climbs the table while it has more steps left than it needs to stop, then
+ * cruises, and comes back down over its last steps, short moves never reach
+ * cruise. Each motor has its own move and place in the table, and keeps its
+ * absolute position in steps of its drive mode, modulo one turn. Each motor
+ * is driven full or half step from one coil table, the profile works in full
+ * steps so the angular speed is the same in both. A move can stop dead on the
+ * opto, for a slow approach, or latch the position where the beam breaks from
+ * the interrupt-on-change and ramp down past it, for a fast seek.
+ */
+#include "step.h"
+
+//Step period in us, 1e6/sqrt(250^2+2*20000*n) and the 1000us cruise
+const uint16_t step_ramp[STEP_RAMP] = {
+    4000,3123,2649,2341,2120,1952,1818,1709,1617,1538,
+    1470,1411,1358,1310,1267,1229,1193,1161,1130,1103,
+    1077,1053,1030,1009,1000
+};
+
+//Half step coil patterns, clockwise order. The even entries are the full
+//steps with two coils on.
+const unsigned char step_coil[STEP_PHASES] = {
+    0b1100, 0b1000, 0b1001, 0b0001, 0b0011, 0b0010, 0b0110, 0b0100
+};
+
+//Opto of each motor on PORTA
+const unsigned char step_opto[STEP_MOTORS] = {0x08, 0x10};
+
+//Global Variables
+unsigned char step_phase[STEP_MOTORS] = {0, 0};    //Coil pattern index
+unsigned char step_res[STEP_MOTORS] = {STEP_FULL, STEP_FULL};  //Drive mode
+
+//Move of each motor
+unsigned char step_dir[STEP_MOTORS];
+unsigned char step_stop[STEP_MOTORS];   //Opto use, 0 or STEP_HALT..STEP_MARK
+unsigned char step_top[STEP_MOTORS] = {STEP_TOP, STEP_TOP};  //Speed limit
+volatile uint16_t step_todo[STEP_MOTORS] = {0, 0};  //Steps left, 0 when idle
+unsigned char step_index[STEP_MOTORS];  //Position in step_ramp
+int16_t step_wait[STEP_MOTORS];     //us to the next step
+volatile unsigned char step_hit[STEP_MOTORS] = {0, 0};  //The opto ended it
+uint16_t step_armed = 0;    //Timer3 interval running, 0 when stopped
+volatile int16_t step_pos[STEP_MOTORS] = {0, 0};    //Position in one turn
+volatile int16_t step_edge[STEP_MOTORS] = {0, 0};   //Position at the beam edge
+
+/*
+ * Configures Timer3 as the step timer on the low priority interrupt.
+ */
+void step_init(){
+    T3CONbits.ON = 0;
+    TMR3CLKbits.CS = 1;     //FOSC/4
+    T3CONbits.CKPS = 0;     //1:1, 1us per tick
+    T3CONbits.RD16 = 1;
+    
+    //Interrupt enable
+    INTCONbits.IPEN = 1;
+    IPR4bits.TMR3IP = 0;
+    PIR4bits.TMR3IF = 0;
+    PIE4bits.TMR3IE = 1;
+    
+    //Opto beam broken, rising edge of RA3 and RA4
+    IOCAP |= step_opto[STEP_RIGHT] | step_opto[STEP_LEFT];
+    IOCAF = 0;
+    IPR0bits.IOCIP = 0;     //Low priority
+    PIE0bits.IOCIE = 1;
+    GIEL = 1;
+    GIEH = 1;
+}
+
+/*
+ * Drive motor m full or half step, only between moves. The position is kept.
+ */
+void step_mode(unsigned char m, unsigned char mode){
+    GIEL = 0;
+    if(mode > step_res[m]){
+        step_pos[m] <<= (mode-step_res[m]);
+    }
+    else{
+        step_pos[m] >>= (step_res[m]-mode);
+    }
+    step_res[m] = mode;
+    GIEL = 1;
+}
+
+/*
+ * Take where motor m is now as position 0, between moves.
+ */
+void step_zero(unsigned char m){
+    GIEL = 0;
+    step_pos[m] = 0;
+    GIEL = 1;
+}
+
+/*
+ * Position of motor m in steps of its drive mode, 0 up to one turn.
+ */
+int16_t step_position(unsigned char m){
+    GIEL = 0;
+    int16_t pos = step_pos[m];
+    GIEL = 1;
+    return pos;
+}
+
+/*
+ * Difference d between two positions of motor m taken the short way round,
+ * never more than half a turn either way.
+ */
+int16_t step_wrap(unsigned char m, int16_t d){
+    int16_t rev = STEP_REV << step_res[m];
+    
+    d %= rev;
+    if(d < 0){
+        d += rev;
+    }
+    if(d > rev/2){  //Shorter the other way
+        d -= rev;
+    }
+    return d;
+}
+
+/*
+ * Shortest move from where motor m is to target, both in steps of its drive
+ * mode. Positive is clockwise.
+ */
+int16_t step_path(unsigned char m, int16_t target){
+    return step_wrap(m, target-step_position(m));
+}
+
+/*
+ * Move where motor m thinks it is, and its latched edge, by d steps without
+ * stepping it. Between moves, to correct drift or restore a saved position.
+ */
+void step_adjust(unsigned char m, int16_t d){
+    int16_t rev = STEP_REV << step_res[m];
+    
+    d = step_wrap(m, d)+rev;
+    GIEL = 0;
+    step_pos[m] = (step_pos[m]+d) % rev;
+    step_edge[m] = (step_edge[m]+d) % rev;
+    GIEL = 1;
+}
+
+/*
+ * Coil table index motor m was last driven with.
+ */
+unsigned char step_coils(unsigned char m){
+    return step_phase[m];
+}
+
+/*
+ * Take motor m as standing at pos with its coils at table index phase,
+ * between moves. Restores a motor that was left there, so the first step
+ * drives the coils next to the ones it stopped on.
+ */
+void step_place(unsigned char m, int16_t pos, unsigned char phase){
+    GIEL = 0;
+    step_pos[m] = pos;
+    step_phase[m] = phase & (STEP_PHASES-1);
+    GIEL = 1;
+}
+
+/*
+ * Steps of motor m per full step.
+ */
+unsigned char step_micro(unsigned char m){
+    return 1 << step_res[m];
+}
+
+/*
+ * Fastest step_ramp entry motor m climbs to on its next moves, STEP_TOP to
+ * cruise or down to STEP_CREEP for the start speed all the way.
+ */
+void step_limit(unsigned char m, unsigned char top){
+    step_top[m] = top;
+}
+
+/*
+ * Start moving motor m by steps in dir, in steps of its drive mode. With opto
+ * STEP_HALT the move ends on the first step that finds the motor's opto beam
+ * broken, only safe at creep speed. With STEP_LATCH the step where the beam
+ * breaks is latched and the move ramps down from there, with STEP_MARK it is
+ * latched and the move carries on. Waits for a move of the same motor that is
+ * still running, the other motor keeps going.
+ */
+void step_move(unsigned char m, uint16_t steps, unsigned char dir, 
+        unsigned char opto){
+    while(step_busy(m)){};
+    
+    step_hit[m] = 0;
+    if(steps == 0){
+        return;
+    }
+    
+    GIEL = 0;
+    step_dir[m] = dir;
+    step_stop[m] = opto;
+    step_index[m] = 0;
+    step_todo[m] = steps;
+    if(step_armed){     //Timer running, wait from its last interrupt
+        step_wait[m] = step_ramp[0]+(int16_t)(TMR3+step_armed);
+    }
+    else{
+        step_wait[m] = step_ramp[0];
+        step_armed = step_ramp[0];
+        TMR3 = 0-step_armed;
+        PIR4bits.TMR3IF = 0;
+        T3CONbits.ON = 1;
+    }
+    GIEL = 1;
+}
+
+/*
+ * One step of motor m, returns its coil pattern. Works out the period to the
+ * following step.
+ */
+unsigned char step_next(unsigned char m){
+    unsigned char res = step_res[m];
+    unsigned char inc = (STEP_PHASES/4) >> res;     //Table entries per step
+    
+    int16_t rev = STEP_REV << res;  //Steps per turn
+    
+    if(step_dir[m] == STEP_CW){
+        step_phase[m] = (step_phase[m]+inc) & (STEP_PHASES-1);
+        if(++step_pos[m] >= rev){
+            step_pos[m] = 0;
+        }
+    }
+    else{
+        step_phase[m] = (step_phase[m]-inc) & (STEP_PHASES-1);
+        if(--step_pos[m] < 0){
+            step_pos[m] = rev-1;
+        }
+    }
+    uint16_t todo = step_todo[m]-1;
+    
+    //Reached the opto
+    if((step_stop[m] == STEP_HALT) && (PORTA & step_opto[m])){
+        step_hit[m] = 1;
+        todo = 0;
+    }
+    
+    //On each full step slow down over the last ones, speed up until cruise
+    //otherwise
+    if((todo & ((1 << res)-1)) == 0){
+        if((todo >> res) <= step_index[m]){
+            if(step_index[m] > 0){
+                step_index[m]--;
+            }
+        }
+        else if(step_index[m] < step_top[m]){
+            step_index[m]++;
+        }
+    }
+    step_wait[m] += step_ramp[step_index[m]] >> res;
+    step_todo[m] = todo;
+    return step_coil[step_phase[m]];
+}
+
+/*
+ * Beam edge of a latching move. Keeps where the motor is and for STEP_LATCH
+ * cuts the move down to the steps it needs to stop from its speed.
+ */
+void step_latch(unsigned char m){
+    uint16_t stop = (uint16_t)(step_index[m]+1) << step_res[m];
+    
+    step_edge[m] = step_pos[m];
+    step_hit[m] = 1;
+    if((step_stop[m] == STEP_LATCH) && (step_todo[m] > stop)){
+        step_todo[m] = stop;
+    }
+}
+
+/*
+ * Called from the low priority interrupt. Latches the opto edges, takes the
+ * steps that are due, within STEP_SLACK, writes both ports and loads the time
+ * to the nearest next step.
+ */
+void step_isr(){
+    if(PIR0bits.IOCIF){
+        unsigned char edge = IOCAF & (step_opto[STEP_RIGHT] | 
+                step_opto[STEP_LEFT]);
+        IOCAF ^= edge;  //Clear only these, keep a new edge
+        for(unsigned char m=0; m<STEP_MOTORS; m++){
+            if((edge & step_opto[m]) && step_todo[m] && 
+                    (step_stop[m] >= STEP_LATCH) && !step_hit[m]){
+                step_latch(m);
+            }
+        }
+    }
+    if(!PIR4bits.TMR3IF){
+        return;
+    }
+    PIR4bits.TMR3IF = 0;
+    
+    int16_t next = 0x7FFF;  //Nearest next step
+    for(unsigned char m=0; m<STEP_MOTORS; m++){
+        if(step_todo[m] == 0){
+            continue;
+        }
+        step_wait[m] -= step_armed;
+        if(step_wait[m] <= STEP_SLACK){
+            unsigned char coil = step_next(m);
+            if(m == STEP_RIGHT){
+                LATB = (LATB & 0xF0) | coil;
+            }
+            else{
+                LATD = (LATD & 0xF0) | coil;
+            }
+        }
+        if(step_todo[m] && (step_wait[m] < next)){
+            next = step_wait[m];
+        }
+    }
+    
+    if(next == 0x7FFF){     //Both idle
+        T3CONbits.ON = 0;
+        step_armed = 0;
+        return;
+    }
+    int16_t now = TMR3;     //Time since the interrupt
+    if(next < now+STEP_SLACK){  //Never behind the timer
+        next = now+STEP_SLACK;
+    }
+    step_armed = next;
+    TMR3 += 0-step_armed;   //From the last interrupt
+}
+
+/*
+ * 1 while motor m is moving.
+ */
+unsigned char step_busy(unsigned char m){
+    GIEL = 0;
+    unsigned char busy = (step_todo[m] != 0);
+    GIEL = 1;
+    return busy;
+}
+
+/*
+ * 1 when the opto ended the last move of motor m.
+ */
+unsigned char step_tripped(unsigned char m){
+    return step_hit[m];
+}
+
+/*
+ * Position where the beam broke on the last latching move of motor m, valid
+ * while step_tripped().
+ */
+int16_t step_latched(unsigned char m){
+    GIEL = 0;
+    int16_t edge = step_edge[m];
+    GIEL = 1;
+    return edge;
+}
@@ -0,0 +1,55 @@
+/*
+ * Header for stepper motor functions.
+ */
+#ifndef STEP_H
+#define	STEP_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+
+//Motors
+#define STEP_MOTORS 2
+#define STEP_RIGHT 0    //Fuel gauge, coils on RB3:0, opto on RA3
+#define STEP_LEFT 1     //Speed gauge, coils on RD3:0, opto on RA4
+
+//Directions
+#define STEP_CW 1
+#define STEP_CCW 2
+
+//Opto use of a move
+#define STEP_HALT 1     //Stop on the first step that finds the beam broken
+#define STEP_LATCH 2    //Latch the position at the beam edge and ramp down
+#define STEP_MARK 3     //Latch the position at the beam edge and keep going
+
+//Drive modes, log2 of the steps per full step
+#define STEP_FULL 0     //Two coils on, 4 states
+#define STEP_HALF 1     //One and two coils in turn, 8 states
+#define STEP_PHASES 8   //Entries in the coil table
+#define STEP_REV 2048   //Full steps per turn of the output shaft
+
+//Profile, step periods in Timer3 ticks (1us)
+#define STEP_RAMP 25    //Entries in the period table, start to cruise
+#define STEP_SEEK 4096  //Move that looks for the opto, two turns
+#define STEP_SLACK 100  //Steps this close are taken together, us
+#define STEP_TOP (STEP_RAMP-1)  //Fastest entry, cruise
+#define STEP_CREEP 0    //Slowest entry, start speed
+
+void step_init();
+void step_mode(unsigned char m, unsigned char mode);
+unsigned char step_micro(unsigned char m);
+void step_limit(unsigned char m, unsigned char top);
+void step_move(unsigned char m, uint16_t steps, unsigned char dir, 
+        unsigned char opto);
+void step_isr();
+unsigned char step_busy(unsigned char m);
+unsigned char step_tripped(unsigned char m);
+int16_t step_latched(unsigned char m);
+void step_zero(unsigned char m);
+int16_t step_position(unsigned char m);
+int16_t step_wrap(unsigned char m, int16_t d);
+int16_t step_path(unsigned char m, int16_t target);
+void step_adjust(unsigned char m, int16_t d);
+unsigned char step_coils(unsigned char m);
+void step_place(unsigned char m, int16_t pos, unsigned char phase);
+
+#endif	/* STEP_H */
@@ -1,415 +1,216 @@
-/* 
- * File:   final_main.c
+/*
+ * File:   main.c
  * Author: Johnny Li
  * Created on April 22, 2020
  * Description:
- * Final design will mimic an infrared (IR) remote receiver such as those used 
- * for TV remotes. I will be using the given microcontroller, PIC18F47K40, from 
- * the course to process inputs from anIR remote to change the ?channels? being 
- * displayed on the LCD.This is done by using a photodiode detect incoming IR 
- * signals and the capture mode on the microcontroller to read the signal. 
- * There will be a I2C timer, being able to set the time and an alarm to an LED 
- * indicate that a mark show time is now happening. The time and alarm will be 
- * set by a digital input from a switch to change time/alarm mode and button to 
- * enable or disable alarm. A potentiometer will be used to alter the voltage 
- * value to the microcontroller ADC to select the values. The time, channel, and
- * alarm status will be displayed on the LCD. If the alarm has triggered, a 
- * digital output from the microcontroller will be set to turn on an LED. An 
- * external DAC using a SPI interface will be used to drive a piezoelectric 
- * speaker for a tone relative to which channel is on.
+ * Raw IR timing capture for tuning the receiver in Final.X. The photodiode
+ * output on RC2 is captured by CCP1 on every edge against Timer1 extended to a
+ * 32-bit timebase (1us ticks at 4MHz). Up to CAP_MAX edge timestamps are kept
+ * per frame, a frame ends after CAP_GAP us without an edge. Each frame is sent
+ * out of EUSART1 TX on RC6 at 38400 baud while the next one is captured into
+ * the other buffer.
+ *
+ * Frame format:
+ * 0xA5             Sync
+ * n                Number of edges
+ * flags            Bit 0: level after the first edge, bit 1: edges dropped
+ * t0 (4 bytes)     First timestamp in us, little endian
+ * n-1 deltas       Time to the previous edge in us, 7 bits per byte, low
+ *                  bits first, bit 7 set when more bytes follow
+ * check            XOR of every byte after the sync
  */
 
 //Includes files
-#include "adc.h"
-#include "lcd.h"
-#include "i2c.h"
-#include "timer.h"
-#include "dac.h"
-#include "ccp.h"
+#include <xc.h>     //Contain the PIC C commands
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 
 //Configuration
 #pragma config WDTE = OFF   //Disable watch dog timer
 #pragma config LVP = ON      //Enable low voltage programming mode
+#define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by
+                            //same frequency.
+
+#define CAP_MAX 80      //Edges per frame, a NEC frame has 68
+#define CAP_GAP 10000   //Idle time that ends a frame in us
+#define CAP_SYNC 0xA5   //Start of a frame on the serial line
+
+//Declare methods
+void uart_init();   //EUSART1 initialization
+void uart_write(unsigned char data);    //EUSART1 write
+void cap_init();    //Timer1 and CCP1 initialization
+uint32_t cap_now();     //Current 32-bit time
+void cap_dump(unsigned char buf);   //Send a captured frame
 
 //Global Variable
-unsigned long value0 = 0;   //Where to store the ADC result
+uint32_t cap_buf[2][CAP_MAX];   //Edge timestamps, double buffered
+volatile unsigned char cap_count[2] = {0, 0};  //Edges in each buffer
+volatile unsigned char cap_flags[2] = {0, 0};  //Frame flags of each buffer
+volatile unsigned char cap_fill = 0;   //Buffer the ISR writes to
+volatile uint16_t cap_high = 0;    //Timer1 overflows, upper 16 bits of time
+unsigned char check = 0;    //Running checksum of the frame being sent
 
 /*
- *
+ * Configures EUSART1 for 38400 baud, 8N1, transmit only on RC6.
  */
-void main() {
-    int setNum=0;   //Switch case selection
-    int AsetNum=0;   //Alarm switch case selection
-    int alarm = 0;  //alarm flag
-    int check = 0;  //Check flag
-    int alarmON = 0;    //Speaker alarm on 
-    int channel=0;  //Channel number
-    
-    adc_init();     //Initialized ADC ports
-    lcd_init();     //Initialize LCD screen, note this takes care of PORTC I/0 
-                    //direction  
-    i2c_init();     //Initialized i2c
-    rtc_init();     //Initialized rtc
-    spi_init();     //Initialized spi
-    //ccp_init();     //Initialize ccp
-    
-    TRISAbits.TRISA2 = 1;  //Configure PORTA pin 2 as input (switch1)
-    TRISAbits.TRISA3 = 1;  //Configure PORTA pin 3 as input (button1)
-    TRISAbits.TRISA4 = 1;  //Configure PORTA pin 4 as input (button2)
-    TRISAbits.TRISA5 = 1;  //Configure PORTA pin 5 as input (alarm)
-    ANSELA = 0x0;   //Clear and Enable
-    TRISAbits.TRISA1 = 0; //Configure PORTA pin 1 as output
-    PORTAbits.RA1 = 0;  //Clear and enable
-    
-    TRISCbits.TRISC0 = 0;   //Configure PORTC pin 0 as output
-    PORTCbits.RC0 = 0;  //Clear and enable
-    TRISCbits.TRISC1 = 0;   //Configure PORTC pin 1 as output
-    PORTCbits.RC1 = 0;  //Clear and enable
-    TRISCbits.TRISC2 = 1;   //Configure PORTC pin 2 as input
-    PORTCbits.RC2 = 0;  //Clear and enable
-    TRISCbits.TRISC5 = 0;   //Configure PORTC pin 5 as output
-    PORTCbits.RC5 = 0;  //Clear and enable
-    
-    //Infinite loop to output the time. 
-    while(1){        
-        if(PORTAbits.RA2==1){   //Set mode
-            //Load adc values
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
-            }
-            else{
-                value0 = ((value0+adcNum0())/2)+1;   //ADC average
-            }
+void uart_init(){
+    TRISCbits.TRISC6 = 0;   //TX
+    RC6PPS = 0x09;  //PPS TX1
 
-            //Convert adc to time unit
-            int u24 = value0/42;    //24 unit
-            int u60 = value0/17;    //60 unit
-            
-            //Next selection
-            if(PORTAbits.RA3!=1){ 
-                setNum++;
-                if (setNum==4){
-                    setNum = 0;
-                }
-                //High to output
-                unsigned long num = 10000L;   //Delay
-                while (--num > 0) {  //Signal change will occur
-                        LATCbits.LATC0 =1;
-                }
-                if (setNum != 0){
-                    LATCbits.LATC0 =0;
-                }
-            }
-            //Set value
-            switch((char)setNum){
-               case 1:
-                   set_hours(u24);
-                   break;
-               case 2:
-                  set_minutes(u60);
-                  break;
-               case 3:
-                   set_seconds(u60);
-                   break;
-               default:
-                    break;
-           }
-            char array[2]; //Storage array
-            //Clear array
-            for(int i=0; i<2; i++){
-                array[i]=0;
-            }
+    BAUD1CONbits.BRG16 = 1;     //16-bit baud generator
+    TX1STAbits.BRGH = 1;    //Baud=FOSC/(4*(SP1BRG+1))
+    SP1BRG = 25;    //38462 baud, 0.2% error
 
-            lcd_char('T');
-            lcd_char(':');
-            lcd_char(' ');
-            //Print format HH/MM/SS
-            //Covert to char array
-            sprintf(array, "%lu", get_hours());
-            char temp1 = array[0];   //Temporary storage
-            char temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%lu", get_minutes());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%lu", get_seconds());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
+    RC1STAbits.SPEN = 1;    //Enable serial port
+    TX1STAbits.TXEN = 1;    //Enable transmit
+}
 
-            //Alarm setting
-            lcd_char(' ');
-            lcd_char(' ');
-            lcd_char(' ');
-            if(alarm == 1){
-                lcd_char('A');
-                lcd_char('S');
-            }
-            else{
-                lcd_char('*');
-                lcd_char('*');
-            }
-            
-            //Set value
-            switch(getr()){
-               case 11:
-                   channel=0;
-                   break;
-               case 12:
-                  channel=1;
-                  break;
-               case 13:
-                   channel=2;
-                   break;
-               default:
-                    break;
-           }
-            
-            //Covert to char array
-            //sprintf(array, "%lu", channel);
-            //temp1 = array[0];   //Temporary storage
-            //Channel output
-            lcd_command(0xC0);  //Next row
-            
-            lcd_char('C');
-            lcd_char('H');
-            lcd_char('A');
-            lcd_char('N');
-            lcd_char('N');
-            lcd_char('E');
-            lcd_char('L');
-            lcd_char(':');
-            lcd_char(' ');
-            if((temp1 != 0)){  //Check if not null
-                lcd_char(temp1);
-            }
-            else {
-                lcd_char('0');
-            }
-            
-            lcd_command(0x02);  //Clear Home
-        }
-        else{   //Alarm mode
-            if(check==0){
-                lcd_command(0x01);  //Clear Home
-                check++;
-            }
-            else if(check==1){
-                lcd_command(0x02);  //Clear Home
-                check--;
-            }
-            
-            //Load adc values
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
-            }
-            else{
-                value0 = ((value0+adcNum0())/2)+1;   //ADC average
-            }
+/*
+ * EUSART1 transmit a byte and add it to the checksum.
+ */
+void uart_write(unsigned char data){
+    while(!TX1IF);  //Wait till the buffer is free
+    TX1REG = data;
+    check ^= data;
+}
 
-            //Convert adc to time unit
-            int u24 = value0/42;    //24 unit
-            int u60 = value0/17;    //60 unit
-            
-            //Next selection
-            if(PORTAbits.RA3!=1){              
-                AsetNum++;
-                if (AsetNum==4){
-                    AsetNum = 0;
-                }
-                //High to output
-                unsigned long num = 10000L;   //Delay
-                while (--num > 0) {  //Signal change will occur
-                        LATCbits.LATC1 =1;
-                }
-                if (AsetNum != 0){
-                    LATCbits.LATC1 =0;
-                }
-            }
-            //Set value
-            switch((char)AsetNum){
-               case 1:
-                   set_Ahours(u24);
-                   break;
-               case 2:
-                    set_Aminutes(u60);
-                    break;
-               case 3:
-                   set_Aseconds(u60);
-                   break;
-               default:
-                    break;
-           }
-            char array[2]; //Storage array
-            //Clear array
-            for(int i=0; i<2; i++){
-                array[i]=0;
-            }
+/*
+ * Timer1 free running at FOSC/4 with the overflow counted in the ISR. CCP1
+ * captures every edge on RC2.
+ */
+void cap_init(){
+    //Timer setup
+    TMR1 = 0;   //Initialize to 0
+    T1CONbits.CKPS = 0;     //1:1, 1us per tick
+    T1CONbits.NOT_SYNC = 0;
+    T1CONbits.RD16 = 1;
+    TMR1CLKbits.CS = 1;     //FOSC/4
+    TMR1IF = 0;
+    TMR1ON = 1;
 
-            lcd_char('A');
-            lcd_char(':');
-            lcd_char(' ');
-            //Print format HH/MM/SS
-            //Covert to char array
-            sprintf(array, "%lu", get_Ahours());
-            char temp1 = array[0];   //Temporary storage
-            char temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%lu", get_Aminutes());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
-            lcd_char(':');
-            //Covert to char array
-            sprintf(array, "%lu", get_Aseconds());
-            temp1 = array[0];   //Temporary storage
-            temp2 = array[1];
-            if((temp1 != 0) && (temp2 != 0)){  //Check if not null
-                lcd_char(temp1);
-                lcd_char(temp2);
-            }
-            else if((temp1 != 0) && (temp2 == 0)){
-                lcd_char('0');
-                lcd_char(temp1); //Print digit
-            }
-            else{
-                lcd_char('0');
-                lcd_char('0');
-            }
+    //CCP setup
+    TRISCbits.TRISC2 = 1;   //Configure PORTC pin 2 as input
+    ANSELC = 0x0;   //Clear and Enable
+    CCP1PPS = 0x12;   //Setup input PPS
+    CCPR1 = 0x00;     //Clear
+    CCP1CONbits.MODE = 0x03;  //Every edge
+    CCP1CONbits.EN = 1;  //Enable ccp
+    CCP1IF = 0;
+
+    //Interrupt enable
+    TMR1IE = 1;
+    CCP1IE = 1;
+    PEIE = 1;
+    GIE = 1;
+}
+
+void __interrupt() ISR(){
+    if (CCP1IF){    //Edge captured, extend it to 32 bits
+        CCP1IF = 0;
+        uint16_t high = cap_high;
+        uint16_t low = CCPR1;
+
+        //Overflow pending but not counted yet, capture was after it
+        if(TMR1IF && (low < 0x8000)){
+            high++;
         }
-        //Check for interrupt
-        if ((i2c_read(RTC, 0x0F)&0x01) == 1){
-            alarmON = 1;
+
+        unsigned char b = cap_fill;
+        unsigned char n = cap_count[b];
+        if(n < CAP_MAX){
+            if(n == 0){     //Level after the first edge
+                cap_flags[b] = PORTCbits.RC2;
+            }
+            cap_buf[b][n] = ((uint32_t)high << 16) | low;
+            cap_count[b] = n+1;
         }
         else{
-            alarmON = 0;
+            cap_flags[b] |= 0x02;   //Edge dropped
         }
-        
-        //Button trigger alarm
-        if (PORTAbits.RA4!=1){
-            if(alarm ==0){  //Set alarm
-                i2c_write(RTC, 0x0E, 0x05);     //Enable interrupt
-                i2c_write(RTC, 0x0A, 0x80);     //Only check hours, minutes, seconds
-                alarm = 1;
-            }
-            else if(alarm ==1){   //Reset alarm
-                i2c_write(RTC, 0x0E, 0x04);     //Disable interrupt
-                alarm = 0;
-            }
-            //High to output
-            unsigned long num = 10000L;   //Delay
-            while (--num > 0) {  //Signal change will occur
-                    LATAbits.LATA1 =1;
-            }
-            LATAbits.LATA1 =0;
+    }
+    if (TMR1IF){    //Upper 16 bits of time
+        TMR1IF = 0;
+        cap_high++;
+    }
+}
+
+/*
+ * Read the 32-bit time without the ISR in the middle.
+ */
+uint32_t cap_now(){
+    uint16_t high;
+    uint16_t low;
+
+    GIE = 0;
+    low = TMR1;
+    high = cap_high;
+    if(TMR1IF && (low < 0x8000)){   //Overflow not counted yet
+        high++;
+    }
+    GIE = 1;
+
+    return ((uint32_t)high << 16) | low;
+}
+
+/*
+ * Send a captured frame out of the serial port.
+ */
+void cap_dump(unsigned char buf){
+    unsigned char n = cap_count[buf];
+    uint32_t t = cap_buf[buf][0];
+
+    check = 0;
+    while(!TX1IF);
+    TX1REG = CAP_SYNC;
+    uart_write(n);
+    uart_write(cap_flags[buf]);
+    uart_write(t);
+    uart_write(t >> 8);
+    uart_write(t >> 16);
+    uart_write(t >> 24);
+
+    //Deltas, 7 bits at a time
+    for(unsigned char i=1; i<n; i++){
+        uint32_t d = cap_buf[buf][i] - cap_buf[buf][i-1];
+        while(d > 0x7F){
+            uart_write((d & 0x7F) | 0x80);
+            d >>= 7;
         }
-        
-        if(alarmON == 1 && alarm == 1){
-           while(PORTAbits.RA4==1){
-                //Speaker tone
-                LATCbits.LATC5=1;
-                __delay_ms(0.25);
-                LATCbits.LATC5=0;
-                __delay_ms(0.25);
-            }
-           i2c_write(RTC, 0x0F,0x00);
+        uart_write(d);
+    }
+
+    uart_write(check);   //Checksum
+    cap_count[buf] = 0;
+}
+
+/*
+ * Wait for a frame to finish, swap buffers and send it while the next frame
+ * is captured.
+ */
+void main() {
+    uart_init();    //Initialized EUSART1
+    cap_init();     //Initialized capture
+
+    //Infinite loop to capture frames.
+    while(1){
+        unsigned char b = cap_fill;
+        unsigned char n = cap_count[b];
+
+        if(n == 0){
+            continue;
         }
-        
-        //Channel DAC output
-        switch(channel){
-           case 0:
-               for(int y=0; y<10; y++){
-                    for (int x = 0; x < 50; x++){
-                         unsigned char volatile outv = (int)(sin[x]);     //Adjust to voltage
-                         spi_write(outv);
-                         __delay_ms(1);
-                    }
-               }
-               break;
-           case 1:
-               for(int y=0; y<10; y++){
-                    for (int x = 0; x < 50; x++){
-                         unsigned char volatile outv = (int)(triangle[x]);     //Adjust to voltage
-                         spi_write(outv);
-                         __delay_ms(1);
-                    }
-               }
-              break;
-           case 2:
-               for(int y=0; y<10; y++){
-                for (int x = 0; x < 50; x++){
-                     unsigned char volatile outv = (int)(sawtooth[x]);     //Adjust to voltage
-                     spi_write(outv);
-                     __delay_ms(1);
-                }
-               }
-               break;
-           default:
-                break;
+
+        //Frame ends when full or idle for the gap
+        if((n < CAP_MAX) && ((cap_now()-cap_buf[b][n-1]) < CAP_GAP)){
+            continue;
         }
+
+        GIE = 0;
+        cap_fill = b^1;     //Capture into the other buffer
+        GIE = 1;
+
+        cap_dump(b);
     }
     return;
 }
-
@@ -3,6 +3,15 @@
  */
 #include "adc.h"
 
+//Global Variables
+const unsigned char adc_scan[ADC_CHANNELS] = ADC_SCAN;  //ADPCH of each input
+const unsigned char adc_smooth[ADC_CHANNELS] = ADC_SMOOTH;  //Filter shifts
+uint16_t adc_acc[ADC_CHANNELS];     //Filter state, result << shift
+volatile uint16_t adc_buf[ADC_CHANNELS][2];     //Results, double buffered
+volatile unsigned char adc_front[ADC_CHANNELS];     //Slot of the newest result
+volatile unsigned char adc_index = 0;   //Input being converted
+volatile unsigned char adc_seq = 0;     //Complete scans, wraps
+
 /*
  * The function will initialize the PORTA pin 0 to be input.
  */
@@ -19,6 +28,7 @@ void adc_init(){
 unsigned long adcNum0() {
     ADCON0 = 0x00;   //Select RA0
     ADPCH = 0;
+    ADCON0bits.CS = 1;  //ADCRC, TAD ~2us at either clock
     ADCON0bits.ADON = 1;    //Enable ADC
     ADCON0bits.GO = 1;  //Set go bit
     
@@ -29,3 +39,185 @@ unsigned long adcNum0() {
     //Shift bits of output
     return (ADRES >> 6);
 }
+
+/*
+ * Get a hardware averaged ADC value from PortA pin 0. One trigger runs a burst
+ * of ADC_AVG conversions and the computation unit returns their mean.
+ */
+unsigned long adcAvg0() {
+    ADCON0 = 0x00;   //Select RA0
+    ADPCH = 0;
+    ADCON0bits.CS = 1;  //ADCRC, TAD ~2us at either clock
+    ADRPT = ADC_AVG;    //Conversions per trigger
+    ADCON2 = 0x00;
+    ADCON2bits.ADCRS = ADC_AVG_SHIFT;   //Divide the sum by ADC_AVG
+    ADCON2bits.ADMD = 0b011;    //Burst average mode
+    ADCON2bits.ADACLR = 1;  //Clear accumulator and count
+    while(ADCON2bits.ADACLR){};
+    ADCON0bits.ADON = 1;    //Enable ADC
+    ADCON0bits.GO = 1;  //Set go bit
+    
+    while(ADCON0bits.GO){};  //Wait til the burst is complete 
+    
+    ADCON0bits.ADON = 0;    //Disable ADC
+    ADCON2 = 0x00;  //Back to single conversions
+    
+    return ADFLTR;
+}
+
+/*
+ * Get a hardware averaged ADC value from PortA pin 0 with the core asleep. The
+ * ADC runs from its own ADCRC oscillator and every conversion wakes the core
+ * through ADIF with interrupts masked, so no ISR runs, then it sleeps again
+ * until the burst is complete. Same burst as adcAvg0() for comparing noise and
+ * current. Anything clocked from FOSC/4, Timer1 included, stops while asleep.
+ */
+unsigned long adcSleep0() {
+    unsigned char gie = INTCONbits.GIE;
+    unsigned char idle = CPUDOZEbits.IDLEN;     //The scheduler leaves it set
+    
+    ADCON0 = 0x00;   //Select RA0
+    ADPCH = 0;
+    ADCON0bits.CS = 1;  //ADCRC, keeps running in Sleep
+    ADRPT = ADC_AVG;    //Conversions per trigger
+    ADCON2 = 0x00;
+    ADCON2bits.ADCRS = ADC_AVG_SHIFT;   //Divide the sum by ADC_AVG
+    ADCON2bits.ADMD = 0b011;    //Burst average mode
+    ADCON2bits.ADACLR = 1;  //Clear accumulator and count
+    while(ADCON2bits.ADACLR){};
+    ADCON0bits.ADON = 1;    //Enable ADC
+    
+    //Wake on conversion complete without vectoring
+    PIR1bits.ADIF = 0;
+    PIE1bits.ADIE = 1;
+    INTCONbits.GIE = 0;
+    
+    CPUDOZEbits.IDLEN = 0;  //SLEEP really sleeps, core noise off
+    ADCON0bits.GO = 1;  //Set go bit
+    while(ADCON0bits.GO){   //Sleep til the burst is complete
+        SLEEP();
+        NOP();
+        PIR1bits.ADIF = 0;
+    }
+    
+    PIE1bits.ADIE = 0;
+    CPUDOZEbits.IDLEN = idle;
+    INTCONbits.GIE = gie;
+    ADCON0bits.ADON = 0;    //Disable ADC
+    ADCON2 = 0x00;  //Back to single conversions
+    
+    return ADFLTR;
+}
+
+/*
+ * Get a value from PortA pin 0 the way ADC_READ selects.
+ */
+unsigned long adcRead0() {
+    if(ADC_READ == ADC_READ_SLEEP){
+        return adcSleep0();
+    }
+    if(ADC_READ == ADC_READ_BUSY){
+        return adcAvg0();
+    }
+    return adcLatest0();
+}
+
+/*
+ * Timer4 dividers for 1:64 at the slow clock, the period stays ADC_PR. The
+ * ADC itself runs from ADCRC, TAD and ADACQ do not follow the clock.
+ */
+void adc_clock(){
+    T4CON = (T4CON & 0x80) | clock_t2con(0b110);
+}
+
+/*
+ * Start the background scan of the ADC_SCAN inputs. Timer4 triggers a burst
+ * average of one input every 5ms, ADACQ sets the acquisition time in hardware
+ * and the ADC threshold interrupt filters and publishes each result before
+ * moving the channel select to the next input. Waits for the first full scan.
+ */
+void adc_start(){
+    if(ADC_READ != ADC_READ_BACKGROUND){   //One shot reads only
+        return;
+    }
+    
+    //Timer4 paces the conversions
+    T4CLKCONbits.CS = 1;    //FOSC/4
+    T4HLT = 0x00;   //Free running
+    adc_clock();    //1:64, 1:1 at 4MHz
+    T4PR = ADC_PR;
+    T4CONbits.ON = 1;
+    clock_add(adc_clock);
+    
+    //ADC setup
+    ADCON0 = 0x00;
+    ADCON0bits.CS = 1;  //ADCRC, TAD ~2us so a fast clock burst stays in spec
+    adc_index = 0;
+    ADPCH = adc_scan[0];    //First input
+    ADACQ = ADC_ACQ;    //Acquisition time, also settles the channel change
+    ADRPT = ADC_AVG;    //Conversions per trigger
+    ADCON2 = 0x00;
+    ADCON2bits.ADCRS = ADC_AVG_SHIFT;   //Divide the sum by ADC_AVG
+    ADCON2bits.ADMD = 0b011;    //Burst average mode
+    ADCON3bits.ADTMD = 0b111;   //Interrupt after every burst
+    ADACT = ADC_TRIGGER;
+    ADCON0bits.ADON = 1;    //Enable ADC
+    
+    //Interrupt enable, low priority so capture keeps its latency
+    INTCONbits.IPEN = 1;
+    IPR1bits.ADTIP = 0;
+    PIR1bits.ADTIF = 0;
+    PIE1bits.ADTIE = 1;
+    GIEL = 1;
+    GIEH = 1;
+    
+    while(adc_seq == 0){};  //First scan
+}
+
+/*
+ * Called from the low priority interrupt. The burst result goes through the
+ * input's low pass filter, out = out + (in - out)/2^shift, into the slot the
+ * main loop is not reading, which then becomes the front slot. The first scan
+ * loads the filters directly.
+ */
+void adc_isr(){
+    if(PIR1bits.ADTIF){
+        PIR1bits.ADTIF = 0;
+        unsigned char i = adc_index;
+        unsigned char k = adc_smooth[i];
+        uint16_t in = ADFLTR;
+        
+        if(adc_seq == 0){
+            adc_acc[i] = in << k;
+        }
+        else{
+            adc_acc[i] = adc_acc[i] - (adc_acc[i] >> k) + in;
+        }
+        
+        unsigned char back = adc_front[i]^1;
+        adc_buf[i][back] = adc_acc[i] >> k;
+        adc_front[i] = back;
+        
+        //Next input
+        if(++i >= ADC_CHANNELS){
+            i = 0;
+            adc_seq++;
+        }
+        adc_index = i;
+        ADPCH = adc_scan[i];
+    }
+}
+
+/*
+ * Newest filtered result of scan input i, never waits.
+ */
+unsigned long adcResult(unsigned char i){
+    return adc_buf[i][adc_front[i]];
+}
+
+/*
+ * Newest filtered result of PortA pin 0, never waits.
+ */
+unsigned long adcLatest0(){
+    return adcResult(ADC_RA0);
+}
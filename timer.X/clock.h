@@ -0,0 +1,38 @@
+/*
+ * Header for clock functions.
+ */
+#ifndef CLOCK_H
+#define	CLOCK_H
+
+#include <xc.h>     //Contain the PIC C commands
+#include <stdint.h>
+
+#define _XTAL_FREQ 4000000  //Delays are built for the slow clock and repeated 
+                            //at the fast one.
+
+//HFINTOSC speeds
+#define CLOCK_SLOW 0    //4MHz, idle and the clock after reset
+#define CLOCK_FAST 1    //64MHz bursts
+#define CLOCK_SLOW_HZ 4000000UL
+#define CLOCK_FAST_HZ 64000000UL
+#define CLOCK_SLOW_FRQ 0x02     //OSCFRQ 4MHz
+#define CLOCK_FAST_FRQ 0x08     //OSCFRQ 64MHz
+#define CLOCK_FAST_SHIFT 4      //log2 of the fast to slow ratio
+
+#define CLOCK_USERS 8   //Callback slots
+
+//Software delays that keep their length at either clock
+#define CLOCK_DELAY_US(us) for(unsigned char clock_n=clock_mult(); clock_n; \
+                                clock_n--){__delay_us(us);}
+#define CLOCK_DELAY_MS(ms) for(unsigned char clock_n=clock_mult(); clock_n; \
+                                clock_n--){__delay_ms(ms);}
+
+void clock_init();
+unsigned char clock_add(void (*fn)(void));
+void clock_set(unsigned char speed);
+uint32_t clock_hz();
+unsigned char clock_shift();
+unsigned char clock_mult();
+unsigned char clock_t2con(unsigned char ckps);
+
+#endif	/* CLOCK_H */
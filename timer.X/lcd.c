@@ -3,6 +3,22 @@
  */
 #include "lcd.h"
 
+//Global Variables
+unsigned char lcd_ready = 0;    //Init done, short waits from now on
+
+/*
+ * Wait between nibble writes. The init sequence needs the slow 5ms, after that
+ * the controller takes about 40us per character.
+ */
+void lcd_wait(){
+    if(lcd_ready){
+        CLOCK_DELAY_US(LCD_STEP_US);
+    }
+    else{
+        CLOCK_DELAY_MS(5);
+    }
+}
+
 /*
  * Handles the writing to the LCD through PORTD.
  * The function will write a command to the command register of the LCD screen. 
@@ -25,31 +41,35 @@ void lcd_command(char x){
 	
     //Clear PORTD
     PORTD = 0;
-    __delay_ms(5);
+    lcd_wait();
 
 	x = x >>4;      //Left shift bit
 	x = x & 0xF;    //Random values for the 4 LSB
 	x = x | 0x80;   //Enable signal
 	PORTD = x;      //Output to PORTD
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0xF;
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	PORTD = 0;  //Clear for next line
-	__delay_ms(5);
+	lcd_wait();
     
     //Second line input, repeat the process of the first
 	x = temp;
 	x = x & 0xF;
 	x = x | 0x80;
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0xF;
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
+    
+    if(lcd_ready && ((unsigned char)temp <= 0x03)){    //Clear and home are slow
+        CLOCK_DELAY_MS(2);
+    }
 }
 
 /*
@@ -64,6 +84,7 @@ void lcd_init(void){
 	lcd_command(0x2C);  //Enable 2-line mode
 	lcd_command(0x0C);  //Turned off blink and cursor, set to 0x0F to turn on
 	lcd_command(0x01);  //Clear Home
+    lcd_ready = 1;
 }
 
 /*
@@ -87,29 +108,29 @@ void lcd_char(char x){
     
     //Clear PORTD
 	PORTD = 0x10;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x >>4;      //Left shift bit
 	x = x & 0xF;    //Random values for the 4 LSB
 	x = x | 0x90;   //Enable signal and organize data character
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0x1F;
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	PORTD = 0x10;   //Reset
-	__delay_ms(5);
+	lcd_wait();
     
     //Second line input, repeat the process of the first
 	x = temp;
 	x = x & 0xF;
 	x = x | 0x90;
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0x1F;
 	PORTD = x;
-	__delay_ms(5);
+	lcd_wait();
 }
\ No newline at end of file
@@ -8,9 +8,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include "clock.h"
 
-#define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by 
-                            //same frequency.
+#define LCD_STEP_US 50  //Wait between nibble writes after init
 
 void lcd_init(void);
 void lcd_command(char);
@@ -22,8 +22,10 @@
 
 //Includes files
 #include "adc.h"
+#include "btn.h"
 #include "lcd.h"
 #include "i2c.h"
+#include "tone.h"
 
 //Configuration
 #pragma config WDTE = OFF   //Disable watch dog timer
@@ -312,6 +314,14 @@ void set_Ahours(unsigned char Ahour){
 	}	
 }
 
+/*
+ * Low priority interrupt, background ADC results and the button tick.
+ */
+void __interrupt(low_priority) ISR_low(){
+    adc_isr();
+    btn_isr();
+}
+
 /*
  *
  */
@@ -321,12 +331,15 @@ void main() {
     int alarm = 0;  //alarm flag
     int check = 0;  //Check flag
     int alarmON = 0;    //Speaker alarm on 
+    unsigned char ringing = 0;  //Alarm tone playing
     
     adc_init();     //Initialized ADC ports
     lcd_init();     //Initialize LCD screen, note this takes care of PORTC I/0 
                     //direction  
     i2c_init();     //Initialized i2c
     rtc_init();     //Initialized rtc
+    adc_start();    //Start background ADC
+    tone_init();    //Alarm tone, off
     
     TRISAbits.TRISA2 = 1;  //Configure PORTA pin 2 as input (switch1)
     TRISAbits.TRISA3 = 1;  //Configure PORTA pin 3 as input (button1)
@@ -343,16 +356,57 @@ void main() {
     TRISCbits.TRISC5 = 0;   //Configure PORTC pin  as output
     PORTCbits.RC5 = 0;  //Clear and enable
     
+    btn_init();     //Start sampling the buttons
+    
     //Infinite loop to output the time. 
     while(1){        
-        if(PORTAbits.RA2==1){   //Set mode
-            //Load adc values
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
+        //Button events
+        unsigned char btn;  //Input of the event
+        unsigned char event;    //Press, release or long press
+        while((event = btn_get_event(&btn)) != BTN_NONE){
+            if((btn == BTN_NEXT) && (event == BTN_PRESS)){  //Next selection
+                if(btn_down(BTN_MODE)){
+                    setNum = (setNum+1)%8;
+                    LATCbits.LATC0 = 1;
+                }
+                else{
+                    AsetNum = (AsetNum+1)%4;
+                    LATCbits.LATC1 = 1;
+                }
             }
-            else{
-                value0 = ((value0+adcNum0())/2)+1;   //ADC average
+            else if((btn == BTN_NEXT) && (event == BTN_LONG)){  //Stop setting
+                setNum = 0;
+                AsetNum = 0;
+            }
+            else if((btn == BTN_NEXT) && (event == BTN_RELEASE)){
+                LATCbits.LATC0 = 0;     //Whichever the press lit
+                LATCbits.LATC1 = 0;
+            }
+            else if((btn == BTN_ALARM) && (event == BTN_PRESS)){    //Alarm on/off
+                if(ringing){    //Silence it first
+                    tone_stop();
+                    i2c_write(RTC, 0x0F,0x00);
+                    ringing = 0;
+                }
+                if(alarm ==0){  //Set alarm
+                    i2c_write(RTC, 0x0E, 0x05);     //Enable interrupt
+                    i2c_write(RTC, 0x0A, 0x80);     //Only check hours, minutes, seconds
+                    alarm = 1;
+                }
+                else if(alarm ==1){   //Reset alarm
+                    i2c_write(RTC, 0x0E, 0x04);     //Disable interrupt
+                    alarm = 0;
+                }
+                LATCbits.LATC2 = 1;
             }
+            else if((btn == BTN_ALARM) && (event == BTN_RELEASE)){
+                LATCbits.LATC2 = 0;
+            }
+        }
+        
+        if(btn_down(BTN_MODE)){   //Set mode
+            //Load adc values
+            value0 = adcRead0();   //Background unless ADC_READ says otherwise
 
             //Convert adc to time unit
             int u24 = value0/42;    //24 unit
@@ -362,21 +416,6 @@ void main() {
             int u31 = (value0/33)+1;    //31 unit
             int u99 = value0/10;    //100 unit
             
-            //Next selection
-            if(PORTAbits.RA3!=1){ 
-                setNum++;
-                if (setNum==8){
-                    setNum = 0;
-                }
-                //High to output
-                unsigned long num = 10000L;   //Delay
-                while (--num > 0) {  //Signal change will occur
-                        LATCbits.LATC0 =1;
-                }
-                if (setNum != 0){
-                    LATCbits.LATC0 =0;
-                }
-            }
             //Set value
             switch((char)setNum){
                case 1:
@@ -584,32 +623,12 @@ void main() {
             }
             
             //Load adc values
-            if(value0 == 0){    //Average out value
-                value0 = adcNum0();
-            }
-            else{
-                value0 = ((value0+adcNum0())/2)+1;   //ADC average
-            }
+            value0 = adcRead0();   //Background unless ADC_READ says otherwise
 
             //Convert adc to time unit
             int u24 = value0/42;    //24 unit
             int u60 = value0/17;    //60 unit
             
-            //Next selection
-            if(PORTAbits.RA3!=1){              
-                AsetNum++;
-                if (AsetNum==4){
-                    AsetNum = 0;
-                }
-                //High to output
-                unsigned long num = 10000L;   //Delay
-                while (--num > 0) {  //Signal change will occur
-                        LATCbits.LATC1 =1;
-                }
-                if (AsetNum != 0){
-                    LATCbits.LATC1 =0;
-                }
-            }
             //Set value
             switch((char)AsetNum){
                case 1:
@@ -694,34 +713,9 @@ void main() {
             alarmON = 0;
         }
         
-        //Button trigger alarm
-        if (PORTAbits.RA4!=1){
-            if(alarm ==0){  //Set alarm
-                i2c_write(RTC, 0x0E, 0x05);     //Enable interrupt
-                i2c_write(RTC, 0x0A, 0x80);     //Only check hours, minutes, seconds
-                alarm = 1;
-            }
-            else if(alarm ==1){   //Reset alarm
-                i2c_write(RTC, 0x0E, 0x04);     //Disable interrupt
-                alarm = 0;
-            }
-            //High to output
-            unsigned long num = 10000L;   //Delay
-            while (--num > 0) {  //Signal change will occur
-                    LATCbits.LATC2 =1;
-            }
-            LATCbits.LATC2 =0;
-        }
-        
-        if(alarmON == 1){
-            while(PORTAbits.RA4==1){
-                //Speaker tone
-                LATCbits.LATC5=1;
-                __delay_ms(0.25);
-                LATCbits.LATC5=0;
-                __delay_ms(0.25);
-            }
-            i2c_write(RTC, 0x0F,0x00);
+        if(alarmON == 1 && !ringing){  //Til the alarm button
+            tone_start();
+            ringing = 1;
         }
     }
     return;
@@ -0,0 +1,59 @@
+/*
+ * Alarm tone functions.
+ * CCP2 in PWM mode on Timer6 makes a 2kHz square wave and PPS routes it to
+ * RC5 while the tone plays. The hardware does all of it, there is no interrupt
+ * and no CPU time spent on the tone.
+ */
+#include "tone.h"
+
+/*
+ * Timer6 dividers for 1:4 at the slow clock. Only the prescaler sets the PWM
+ * period, clock_t2con() keeps it on the prescaler up to 1:128.
+ */
+void tone_clock(){
+    T6CON = (T6CON & 0x80) | clock_t2con(0b010);
+}
+
+/*
+ * Configures Timer6 and CCP2 for the tone, RC5 stays a low output until
+ * tone_start().
+ */
+void tone_init(){
+    TRISCbits.TRISC5 = 0;   //Speaker
+    LATCbits.LATC5 = 0;
+    
+    //Timer6 setup
+    T6CLKCONbits.CS = 1;    //FOSC/4
+    T6HLT = 0x00;   //Free running
+    tone_clock();   //1:4, 1:1 at 4MHz
+    T6PR = TONE_PR;
+    
+    //CCP2 setup
+    CCPTMRSbits.C2TSEL = 0b11;  //PWM on Timer6
+    CCP2CON = 0x00;
+    CCP2CONbits.FMT = 0;    //Right aligned duty
+    CCP2CONbits.MODE = 0b1111;  //PWM
+    CCPR2 = TONE_DUTY;
+    
+    clock_add(tone_clock);
+}
+
+/*
+ * Start the alarm tone on RC5.
+ */
+void tone_start(){
+    TMR6 = 0;
+    T6CONbits.ON = 1;
+    CCP2CONbits.EN = 1;
+    RC5PPS = TONE_PPS;
+}
+
+/*
+ * Stop the alarm tone and leave RC5 low.
+ */
+void tone_stop(){
+    LATCbits.LATC5 = 0;
+    RC5PPS = 0x00;  //Back to LATC5
+    CCP2CONbits.EN = 0;
+    T6CONbits.ON = 0;
+}
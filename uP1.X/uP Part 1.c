@@ -18,8 +18,80 @@
 #define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by 
                             //same frequency.
 
+//2kHz speaker tone, PWM3 on Timer2 at FOSC/4
+#define TONE_PR 124     //1MHz/4/125 = 2kHz
+#define TONE_DUTY 250   //50%, half of 4*(TONE_PR+1)
+//2Hz LED blink, PWM4 on Timer4 from LFINTOSC so it runs in Sleep
+#define BLINK_PR 120    //31kHz/128/121 = 2Hz
+#define BLINK_DUTY 242  //50%, half of 4*(BLINK_PR+1)
+
+//PPS output values
+#define PPS_LAT 0x00
+#define PPS_PWM3 0x07
+#define PPS_PWM4 0x08
+
+/*
+ * Sets up both outputs. Timer2 and PWM3 make the speaker tone and Timer4 and
+ * PWM4 the LED blink, each stays off the pin until out_select() routes it.
+ */
+void pwm_init(){
+    //Timer2, tone period
+    T2CLKCONbits.CS = 1;    //FOSC/4
+    T2HLT = 0x00;   //Free running
+    T2CONbits.CKPS = 0b010; //1:4
+    T2CONbits.OUTPS = 0;    //1:1
+    T2PR = TONE_PR;
+    
+    //Timer4, blink period
+    T4CLKCONbits.CS = 0b0100;   //LFINTOSC, keeps running in Sleep
+    T4HLT = 0x00;   //Free running
+    T4CONbits.CKPS = 0b111; //1:128
+    T4CONbits.OUTPS = 0;    //1:1
+    T4PR = BLINK_PR;
+    
+    //PWM3 on Timer2, PWM4 on Timer4
+    CCPTMRSbits.P3TSEL = 0b01;
+    CCPTMRSbits.P4TSEL = 0b10;
+    PWM3DCH = TONE_DUTY >> 2;   //Duty is 10 bits, left aligned
+    PWM3DCL = (TONE_DUTY & 0x03) << 6;
+    PWM4DCH = BLINK_DUTY >> 2;
+    PWM4DCL = (BLINK_DUTY & 0x03) << 6;
+    PWM3CONbits.EN = 1;
+    PWM4CONbits.EN = 1;
+}
+
 /*
- * Continuously loop/poll for switch input to determine function of the program.
+ * Route the output the switch asks for and stop the other one, its pin is
+ * left low. Switch set blinks the LED, switch clear sounds the speaker.
+ */
+void out_select(){
+    if(PORTBbits.RB0==1){
+        RA1PPS = PPS_LAT;   //Speaker off
+        T2CONbits.ON = 0;
+        T4CONbits.ON = 1;
+        RA0PPS = PPS_PWM4;  //LED blinks
+    }
+    else{
+        RA0PPS = PPS_LAT;   //LED off
+        T4CONbits.ON = 0;
+        T2CONbits.ON = 1;
+        RA1PPS = PPS_PWM3;  //Speaker tone
+    }
+}
+
+/*
+ * Switch changed, either edge on RB0.
+ */
+void __interrupt() ISR(){
+    if(PIR0bits.IOCIF){
+        IOCBFbits.IOCBF0 = 0;
+        out_select();
+    }
+}
+
+/*
+ * The PWM modules make both signals, the CPU only wakes to move them when the
+ * switch changes.
  * If switch is on/set, the LED with blink at 2Hz.
  * If switch is off/close, the speaker will sound at 2kHz.
  * Contain setup of I/O values - PORTA is output while PORTB is input. 
@@ -35,47 +107,29 @@ int main() {
     //Clear and Enable PortB
     ANSELB = 0x0;
     
+    pwm_init();     //Tone and blink generators
+    out_select();   //Start with the switch as it is
+    
+    //Interrupt on either edge of the switch
+    IOCBPbits.IOCBP0 = 1;
+    IOCBNbits.IOCBN0 = 1;
+    IOCBFbits.IOCBF0 = 0;
+    PIE0bits.IOCIE = 1;
+    PEIE = 1;
+    GIE = 1;
+    
     //Infinite Loop
-    //Since the manual switching is slower than the delays, polling will work as
-    //if instant interrupt. 
+    //Sleep while blinking, the LFINTOSC timer keeps going. The tone timer runs
+    //from FOSC/4 so only the core stops (Idle). GIE is off around the choice,
+    //a switch change just before SLEEP still wakes it.
     while(1){
-        //Turning the voltage output of the pin connected to the LED to high and
-        //low causes blinking.
-       
-        //If input PortB pin0 is set, toggle LED on
-        if(PORTBbits.RB0==1){
-            //Set/turn on LED to output PortA pin 0
-            LATAbits.LATA0=1;
-            __delay_ms(250); //Delay by 500ms -> 2Hz but half duty cycle so 
-                             //250ms
-        }
-        //Continue LED function if switch PortB pin0 is still set
-        if(PORTBbits.RB0==1){
-            //Ground/turn off LED to output PortA pin 0
-            LATAbits.LATA0=0;
-            __delay_ms(250);
-        }
-        
-        //Turning the voltage output of the pin high and low in a digital signal
-        //simulate a square wave so when the connected output pin will generate
-        //a 2kHz square wave to the speaker if it is toggled fasted enough.
-        
-        //If input PortB pin0 is close, turn on speaker
-        if(PORTBbits.RB0==0){
-            //High to output PortA pin 1
-            LATAbits.LATA1 =1;
-            __delay_ms(0.25); //Delay by 0.5ms -> 2kHz but half duty cycle so 
-                              //0.25ms
-        }
-        //Continue speaker function if switch PortB pin0 is still close
-        if(PORTBbits.RB0==0){
-            //Low to output PortA pin 1
-            LATAbits.LATA1=0;
-            __delay_ms(0.25);
-        }
+        GIE = 0;
+        CPUDOZEbits.IDLEN = T2CONbits.ON;
+        SLEEP();
+        NOP();
+        GIE = 1;
     };
     
     //Does not reach return
     return 0;
 }
-
@@ -5,8 +5,10 @@
  * Description:
  * A microcontroller based system that measures the resistance of a resistor
  * displaying the resistance in Ohms on an LCD display. The resistance ranges 
- * from 500Ohm to 2MOhm but only display the value at a range of 1kOhm to 1MOhm.
- * If resistance exceeds 1MOhms or is less than 1kOhms, the LCD will display 
+ * from 500Ohm to 2MOhm. The unknown resistor goes from RA0 to GND and one of
+ * four reference resistors on RB0-RB3 pulls RA0 up, the range is picked
+ * automatically so the reading stays near the middle of the ADC scale.
+ * If resistance exceeds 2MOhms or is less than 500Ohms, the LCD will display 
  * "Out of Range".
  * Output Format: R=XXXXXXX Ohms
  */
@@ -29,6 +31,8 @@
  * PIN8:  DB5 = RC1
  * PIN9:  DB6 = RC2
  * PIN10: DB7 = RC3
+ *
+ * Reference resistors to RA0: RB0 = 1k, RB1 = 10k, RB2 = 100k, RB3 = 1M
  * 
  * Note: RA6 and RA7 need to be configured because they share 
  * pins with external oscillators so PORTA was abandon and PORTC was used 
@@ -39,6 +43,7 @@
 #include <xc.h>     //Contain the PIC C commands
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 //Configuration
 #pragma config WDTE = OFF   //Disable watch dog timer
@@ -46,18 +51,98 @@
 #define _XTAL_FREQ 4000000  //The default clock is 4MHz so set delay clock by 
                             //same frequency.
 
+//Oversampling, 4^n conversions summed and shifted right by n give n extra bits
+#define ADC_OS_BITS 2   //Extra bits, 2 = 12-bit, 3 = 13-bit
+#define ADC_OS_COUNT (1 << (2*ADC_OS_BITS))     //Conversions per reading
+#define ADC_BITS (10+ADC_OS_BITS)   //Bits per reading
+#define ADC_SCALE (1UL << ADC_BITS)     //Reading of Vdd
+#define ADC_OFFSET (2UL << ADC_OS_BITS)     //Zero offset of the converter
+#define ADC_ACQ 25  //Acquisition time in TAD
+#define ADC_PR 155  //Timer4 period, 1MHz/64/156 = 100 readings per second
+#define ADC_TRIGGER 0x06    //ADACT Timer4 postscaled
+#define ADC_SMOOTH 2    //Low pass shift of the published reading
+
+//Display
+#define DISP_READINGS 15    //Readings per refresh, 100Hz/15 = 6.7Hz
+#define DISP_HYST 9     //Display moves when off by more than 1/2^9 (0.2%)+1
+#define LCD_WIDTH 16
+#define LCD_STEP_US 50  //Wait between nibble writes after init
+
+//Ranges, reference resistors on RB0-RB3 with the port driver in series
+#define RANGES 4
+#define R_REF0 1000
+#define R_REF1 10000
+#define R_REF2 100000
+#define R_REF3 1000000
+#define R_PIN 25    //Port driver resistance, lowest range only, <0.3% above
+#define RANGE_MASK 0x0F     //PORTB pins of the references
+#define R_MIN 500   //Display range
+#define R_MAX 2000000
+#define R_OPEN 0xFFFFFFFF   //Above the top range
+
+//Switch range when the unknown is 4x above or 4x below the reference, the
+//10x step between references leaves room for hysteresis
+#define ADC_UP (ADC_SCALE*4/5)  //Rx > 4*Rref
+#define ADC_DOWN (ADC_SCALE/5)  //Rx < Rref/4
+
+//Lookup tables, Rx = Rref*code/(scale-code) at ADC_SEG points over the scale
+//and linear interpolation in between
+#define ADC_SEG_BITS 6
+#define ADC_SEG (1 << ADC_SEG_BITS)
+#define ADC_FRAC_BITS (ADC_BITS-ADC_SEG_BITS)   //Code bits inside a segment
+#define ADC_FRAC_MASK ((1 << ADC_FRAC_BITS)-1)
+#define RT(r, i) ((unsigned long)(r)*(i)/(ADC_SEG-(i)))
+#define RT8(r, i) RT(r, i), RT(r, i+1), RT(r, i+2), RT(r, i+3), \
+                  RT(r, i+4), RT(r, i+5), RT(r, i+6), RT(r, i+7)
+#define RTABLE(r) {RT8(r, 0), RT8(r, 8), RT8(r, 16), RT8(r, 24), \
+                   RT8(r, 32), RT8(r, 40), RT8(r, 48), RT8(r, 56), R_OPEN}
+
 //Declare methods
 void lcd_init(void);
+void lcd_wait(void);
 void lcd_command(char);
 void lcd_char(char);
 void adc_init(void);
-unsigned long adcNum();
+void adc_start();
+void range_set(unsigned char r);
+unsigned long ohms(unsigned long code, unsigned char r);
+void lcd_show(const char *line);
 
 //Global Variable
-unsigned long value; //Where to store the ADC result in
 unsigned long R;  //Resistance
-unsigned long r1 = 33000;   //Resistor value
-int volt = 5; //Voltage
+unsigned char range = 0;    //Selected reference
+unsigned char settle = 0;   //Readings to drop after a range change
+uint16_t adc_acc = 0;   //Filter state, reading << ADC_SMOOTH
+
+//Published readings, double buffered with the range they were taken on
+volatile uint16_t adc_code[2];
+volatile unsigned char adc_range[2];
+volatile unsigned char adc_front = 0;   //Slot of the newest reading
+volatile unsigned char adc_seq = 0;     //Readings published, wraps
+
+char lcd_shadow[LCD_WIDTH];     //What the first line shows now
+unsigned char lcd_ready = 0;    //Init done, short waits from now on
+
+//Code to ohms of every range, built by the compiler
+const unsigned long r_table[RANGES][ADC_SEG+1] = {
+    RTABLE(R_REF0+R_PIN),
+    RTABLE(R_REF1),
+    RTABLE(R_REF2),
+    RTABLE(R_REF3)
+};
+
+/*
+ * Wait between nibble writes. The init sequence needs the slow 5ms, after that
+ * the controller takes about 40us per character.
+ */
+void lcd_wait(void){
+    if(lcd_ready){
+        __delay_us(LCD_STEP_US);
+    }
+    else{
+        __delay_ms(5);
+    }
+}
 
 /*
  * Handles the writing to the LCD through PORTC.
@@ -81,31 +166,35 @@ void lcd_command(char x){
 	
     //Clear PORTC
     PORTC = 0;
-    __delay_ms(5);
+    lcd_wait();
 
 	x = x >>4;      //Left shift bit
 	x = x & 0xF;    //Random values for the 4 LSB
 	x = x | 0x80;   //Enable signal
 	PORTC = x;      //Output to PORTC
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0xF;
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	PORTC = 0;  //Clear for next line
-	__delay_ms(5);
+	lcd_wait();
     
     //Second line input, repeat the process of the first
 	x = temp;
 	x = x & 0xF;
 	x = x | 0x80;
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0xF;
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
+    
+    if(lcd_ready && ((unsigned char)temp <= 0x03)){    //Clear and home are slow
+        __delay_ms(2);
+    }
 }
 
 /*
@@ -120,6 +209,7 @@ void lcd_init(void){
 	lcd_command(0x2C);  //Enable 2-line mode
 	lcd_command(0x0C);  //Turned off blink and cursor, set to 0x0F to turn on
 	lcd_command(0x01);  //Clear Home
+    lcd_ready = 1;
 }
 
 /*
@@ -143,31 +233,31 @@ void lcd_char(char x){
     
     //Clear PORTC
 	PORTC = 0x10;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x >>4;      //Left shift bit
 	x = x & 0xF;    //Random values for the 4 LSB
 	x = x | 0x90;   //Enable signal and organize data character
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0x1F;
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	PORTC = 0x10;   //Reset
-	__delay_ms(5);
+	lcd_wait();
     
     //Second line input, repeat the process of the first
 	x = temp;
 	x = x & 0xF;
 	x = x | 0x90;
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
     
 	x = x & 0x1F;
 	PORTC = x;
-	__delay_ms(5);
+	lcd_wait();
 }
 
 /*
@@ -177,38 +267,165 @@ void lcd_char(char x){
  * conversion.
  * ADCON2- ADFLTR is transferred to ADPREV at start-of-conversion and ADACC, 
  * ADAOV and ADCNT registers are cleared.
+ * ADCLK- FOSC/8, 2us TAD.
+ * ADACQ- Acquisition time before each conversion in hardware instead of a 
+ * delay.
+ * ADRPT/ADCRS- Burst of ADC_OS_COUNT conversions, the sum is shifted right by
+ * ADC_OS_BITS (decimation). A reading takes about ADC_OS_COUNT*(ADC_ACQ+12)
+ * TAD.
  */
 void adc_init(){
     TRISAbits.TRISA0 = 1;  //Configure PORTA pin 0 as input
     ADCON0 = 0x0;   //Disabled ADC and select RA0
+    ADCON0bits.ADFM = 1;    //Right justified for the accumulator
+    ADCLK = 3;      //FOSC/(2*(3+1))
+    ADACQ = ADC_ACQ;
+    ADRPT = ADC_OS_COUNT;   //Conversions per reading
+    ADCON2 = 0x0;
+    ADCON2bits.ADCRS = ADC_OS_BITS;     //Decimate
+    ADCON2bits.ADMD = 0b011;    //Burst average mode
 }
 
 /*
- * Get the ADC value and convert it to a char.
+ * Sample in the background. Timer4 triggers one oversampled burst every 10ms
+ * and the ADC threshold interrupt handles the result.
  */
-unsigned long adcNum() {
+void adc_start(){
+    //Timer4 paces the readings
+    T4CLKCONbits.CS = 1;    //FOSC/4
+    T4HLT = 0x00;   //Free running
+    T4CONbits.CKPS = 0b110; //1:64
+    T4CONbits.OUTPS = 0;    //1:1
+    T4PR = ADC_PR;
+    T4CONbits.ON = 1;
+    
+    ADCON3bits.ADTMD = 0b111;   //Interrupt after every burst
+    ADACT = ADC_TRIGGER;
     ADCON0bits.ADON = 1;    //Enable ADC
-    ADCON0bits.GO = 1;  //Set go bit
-    __delay_ms(5);
     
-    while(ADCON0bits.GO){};  //Wait til conversion is complete 
+    //Interrupt enable
+    PIR1bits.ADTIF = 0;
+    PIE1bits.ADTIE = 1;
+    PEIE = 1;
+    GIE = 1;
+}
+
+/*
+ * Drive reference r high and leave the others floating. Unused pins stay
+ * analog so their input buffers do not load RA0. The next reading is dropped
+ * while RA0 settles.
+ */
+void range_set(unsigned char r){
+    TRISB |= RANGE_MASK;    //All references off
+    ANSELB |= RANGE_MASK;
+    LATB = (LATB & ~RANGE_MASK) | (1 << r);
+    TRISB &= ~(1 << r);     //Drive the selected one
+    range = r;
+    settle = 1;
+}
+
+/*
+ * Reading ready. Move to the next range while the reading is near either end
+ * of the scale, the hysteresis keeps it from switching back. Otherwise filter
+ * the reading and publish it with its range into the slot the main loop is
+ * not reading.
+ */
+void __interrupt() ISR(){
+    if(PIR1bits.ADTIF){
+        PIR1bits.ADTIF = 0;
+        uint16_t code = ADFLTR;
+        
+        if(settle){
+            settle = 0;
+            adc_acc = 0xFFFF;   //Reload the filter
+            return;
+        }
+        if((code > ADC_UP) && (range < RANGES-1)){
+            range_set(range+1);
+            return;
+        }
+        if((code < ADC_DOWN) && (range > 0)){
+            range_set(range-1);
+            return;
+        }
+        
+        if(adc_acc == 0xFFFF){
+            adc_acc = code << ADC_SMOOTH;
+        }
+        else{
+            adc_acc = adc_acc - (adc_acc >> ADC_SMOOTH) + code;
+        }
+        
+        unsigned char back = adc_front^1;
+        adc_code[back] = adc_acc >> ADC_SMOOTH;
+        adc_range[back] = range;
+        adc_front = back;
+        adc_seq++;
+    }
+}
+
+/*
+ * Convert a reading taken on range r to ohms.
+ */
+unsigned long ohms(unsigned long code, unsigned char r){
+    if(code > ADC_OFFSET){
+        code = code-ADC_OFFSET;
+    }
+    else{
+        code = 0;
+    }
+    if(code >= ADC_UP){     //Only left on the top range
+        return R_OPEN;
+    }
     
-    ADCON0bits.ADON = 0;    //Disable ADC
+    //Interpolate in the segment
+    unsigned char i = code >> ADC_FRAC_BITS;
+    unsigned long low = r_table[r][i];
+    unsigned long step = r_table[r][i+1]-low;
+    return low + ((step*(code & ADC_FRAC_MASK)) >> ADC_FRAC_BITS);
+}
+
+/*
+ * Show a line on the first row, only writing the characters that changed.
+ * Changed characters next to each other share one cursor move.
+ */
+void lcd_show(const char *line){
+    unsigned char moved = 0;    //Cursor is at the next character
     
-    //Shift bits of output
-    return (ADRES >> 6);
+    for(unsigned char i=0; i<LCD_WIDTH; i++){
+        if(line[i] == lcd_shadow[i]){
+            moved = 0;
+            continue;
+        }
+        if(!moved){
+            lcd_command(0x80 | i);  //Set DDRAM address
+            moved = 1;
+        }
+        lcd_char(line[i]);
+        lcd_shadow[i] = line[i];
+    }
 }
 
 /*
  * Initialize ADC and LCD.
  * Infinite loop to print the resistance of the resistor.
- * Get adc value -> voltage -> resistance.
+ * Readings come in from the background, a few times a second the newest one is
+ * converted to ohms through the range table and the changed digits redrawn.
  * Check if resistance meet the requirements and print out the correct output.
  */
 void main() {
+    unsigned long shown = 0;    //Resistance on the display
+    unsigned char last = 0;     //Reading count at the last refresh
+    
     adc_init();     //Initialized ADC
+    range_set(0);   //Lowest reference
     lcd_init();     //Initialize LCD screen, note this takes care of PORTC I/0 
                     //direction  
+    lcd_command(0x01);  //Clear Home
+    for(unsigned char i=0; i<LCD_WIDTH; i++){
+        lcd_shadow[i] = ' ';
+    }
+    adc_start();    //Start background sampling
    
     /* Test LCD code
      * Infinite loop to output 'X'
@@ -218,64 +435,35 @@ void main() {
     
     //Infinite loop to print the resistance of the resistor. 
     while (1){
-        //Load adc value
-        value = adcNum()-2;
+        //Refresh rate, idle between readings, the ADC interrupt wakes it
+        CPUDOZEbits.IDLEN = 1;  //SLEEP enters Idle
+        while((unsigned char)(adc_seq-last) < DISP_READINGS){
+            SLEEP();
+            NOP();
+        }
+        last = adc_seq;
         
-        //Calculate resistance 
-        unsigned long Vout = (value*volt*1000)/1023;   //Vout = (adc val*Vin)/1023
-        R = (Vout*r1)/((volt*1000)-Vout);   //R2 = (Vout*R1)/(Vin-Vout)
+        //Newest reading
+        unsigned char f = adc_front;
+        R = ohms(adc_code[f], adc_range[f]);
         
-       char array[7]; //Storage array
-       //Clear array
-       for(int i=0; i<7; i++){
-           array[i]=0;
-       }
-       //Covert to char array
-       sprintf(array, "%lu", R);
-       
+        //Hysteresis, hold the shown value through small changes
+        unsigned long diff = (R > shown) ? (R-shown) : (shown-R);
+        if(diff > (shown >> DISP_HYST)+1){
+            shown = R;
+        }
+        
+        char array[LCD_WIDTH+1]; //Storage array
         //Out of bound range
-        if ((R<1000) || (R>1000000)){
-            //Print out of bound
-            lcd_char('O');
-            lcd_char('u');
-            lcd_char('t');
-            lcd_char(' ');
-            lcd_char('o');
-            lcd_char('f');
-            lcd_char(' ');
-            lcd_char('B');
-            lcd_char('o');
-            lcd_char('u');
-            lcd_char('n');
-            lcd_char('d');
+        if ((shown<R_MIN) || (shown>R_MAX)){
+            sprintf(array, "Out of Bound    ");
         }
         else{
-            //Print format R=X XXX XXX Ohms
-            lcd_char('R');
-            lcd_char('=');
-            lcd_char(' ');
-            
-            //Print number
-            for(int i=0; i<7; i++){
-                char temp = array[i];   //Temporary storage
-                if(temp != 0){  //Check if not null
-                    lcd_char(temp); //Print digit
-                }
-                else{
-                    break;
-                }
-            }
-            lcd_char(' ');
-            lcd_char('O');
-            lcd_char('h');
-            lcd_char('m');
-            lcd_char('s');
+            //Print format R=XXXXXXXX Ohms
+            sprintf(array, "R=%8lu Ohms ", shown);
         }
-        __delay_ms(2000); //Static view
-        
-        //Clear display
-        lcd_command(0x01);  //Clear Home
+        lcd_show(array);
     }
     
     return;  //Never to be reached.
-}
\ No newline at end of file
+}